@@ -0,0 +1,235 @@
+#include <array_list/arraylist.hpp>
+#include <memory>
+#include <random>
+#include <vector>
+#include "benchmark/benchmark.h"
+
+namespace {
+constexpr size_t capacity = 4096;
+using List = cdt::ArrayList<int, capacity>;
+
+/// Insert and erase one element at the back of a list that already holds state.range(0) elements.
+void InsertEraseBackAtFill(benchmark::State& state) {
+    List l;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        l.push_back(i);
+    }
+    for (auto _ : state) {
+        l.push_back(1);
+        l.pop_back();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(InsertEraseBackAtFill)->Arg(0)->Arg(capacity / 4)->Arg(capacity / 2)->Arg(3 * capacity / 4)->Arg(capacity - 1);
+
+/// Insert and erase one element at the front of a list that already holds state.range(0) elements.
+void InsertEraseFrontAtFill(benchmark::State& state) {
+    List l;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        l.push_back(i);
+    }
+    for (auto _ : state) {
+        l.push_front(1);
+        l.pop_front();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(InsertEraseFrontAtFill)->Arg(0)->Arg(capacity / 4)->Arg(capacity / 2)->Arg(3 * capacity / 4)->Arg(capacity - 1);
+
+/// Fill the list from empty to full and drain it again.
+void FillAndDrain(benchmark::State& state) {
+    List l;
+    for (auto _ : state) {
+        for (size_t i = 0; i < capacity; i++) {
+            l.push_back(i);
+        }
+        while (!l.empty()) {
+            l.pop_front();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * capacity);
+}
+BENCHMARK(FillAndDrain);
+
+/// Visit all elements of a list of state.range(0) elements by subscript in ascending order.
+void SequentialSubscript(benchmark::State& state) {
+    List l;
+    const size_t n = state.range(0);
+    for (size_t i = 0; i < n; i++) {
+        l.push_back(i);
+    }
+    for (auto _ : state) {
+        long sum = 0;
+        for (size_t i = 0; i < n; i++) {
+            sum += l[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(SequentialSubscript)->Arg(64)->Arg(512)->Arg(capacity);
+
+/// Access random positions of a list of state.range(0) elements by subscript.
+void RandomSubscript(benchmark::State& state) {
+    List l;
+    const size_t n = state.range(0);
+    for (size_t i = 0; i < n; i++) {
+        l.push_back(i);
+    }
+    std::vector<size_t> indices(1024);
+    std::mt19937 rng(42);
+    for (auto& idx : indices) {
+        idx = rng() % n;
+    }
+    for (auto _ : state) {
+        long sum = 0;
+        for (size_t idx : indices) {
+            sum += l[idx];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * indices.size());
+}
+BENCHMARK(RandomSubscript)->Arg(64)->Arg(512)->Arg(capacity);
+
+/// Insert a run of state.range(0) elements element by element and erase it again.
+void InsertEraseRunSingle(benchmark::State& state) {
+    List l;
+    std::vector<int> run(state.range(0), 1);
+    for (auto _ : state) {
+        for (int x : run) {
+            l.push_back(x);
+        }
+        while (!l.empty()) {
+            l.erase(l.begin());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * run.size());
+}
+BENCHMARK(InsertEraseRunSingle)->Arg(16)->Arg(capacity);
+
+/// Insert a run of state.range(0) elements at once and erase it as one range.
+void InsertEraseRunBulk(benchmark::State& state) {
+    List l;
+    std::vector<int> run(state.range(0), 1);
+    for (auto _ : state) {
+        l.insert(l.end(), run.begin(), run.end());
+        l.erase(l.begin(), l.end());
+    }
+    state.SetItemsProcessed(state.iterations() * run.size());
+}
+BENCHMARK(InsertEraseRunBulk)->Arg(16)->Arg(capacity);
+
+/// Full list, where a random half of the elements is stale (odd).
+void FillStale(List& l) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 1);
+    l.clear();
+    for (size_t i = 0; i < capacity; i++) {
+        l.push_back(dist(rng));
+    }
+}
+
+/// Purge the stale elements of a full list by erasing one element at a time.
+void PurgeErase(benchmark::State& state) {
+    List l;
+    for (auto _ : state) {
+        state.PauseTiming();
+        FillStale(l);
+        state.ResumeTiming();
+        for (auto it = l.begin(); it != l.end();) {
+            if (*it & 1) {
+                it = l.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * capacity);
+}
+BENCHMARK(PurgeErase);
+
+/// Purge the stale elements of a full list in a single remove_if() traversal.
+void PurgeRemoveIf(benchmark::State& state) {
+    List l;
+    for (auto _ : state) {
+        state.PauseTiming();
+        FillStale(l);
+        state.ResumeTiming();
+        l.remove_if([](int x) { return x & 1; });
+    }
+    state.SetItemsProcessed(state.iterations() * capacity);
+}
+BENCHMARK(PurgeRemoveIf);
+
+/// Move the first half of a full list behind its second half.
+void SpliceHalf(benchmark::State& state) {
+    List l;
+    for (size_t i = 0; i < capacity; i++) {
+        l.push_back(i);
+    }
+    auto middle = l.nth(capacity / 2);
+    for (auto _ : state) {
+        auto first = l.begin();
+        l.splice(l.end(), l, first, middle);
+        middle = first;
+    }
+}
+BENCHMARK(SpliceHalf);
+
+/// Cache line sized payload, sorted by a random key.
+struct Sample {
+    bool operator<(const Sample& other) const {
+        return key < other.key;
+    }
+    unsigned key;
+    char body[60];
+};
+
+/// Sum a large list, whose order has been scrambled by sorting, before (state.range(0) == 0) and after compaction.
+void IterateAfterChurn(benchmark::State& state) {
+    constexpr size_t large_capacity = 1 << 16;
+    std::unique_ptr<cdt::ArrayList<Sample, large_capacity, cdt::SplitLayout>> l(
+            new cdt::ArrayList<Sample, large_capacity, cdt::SplitLayout>());
+    std::mt19937 rng(42);
+    for (size_t i = 0; i < large_capacity; i++) {
+        l->push_back(Sample{static_cast<unsigned>(rng()), {}});
+    }
+    l->sort();
+    if (state.range(0)) {
+        l->compact();
+    }
+    for (auto _ : state) {
+        unsigned long sum = 0;
+        for (auto it = l->begin(); it != l->end(); ++it) {
+            sum += it->key;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * large_capacity);
+}
+BENCHMARK(IterateAfterChurn)->Arg(0)->Arg(1);
+
+/// Payload standing in for a heavy message struct.
+struct Message {
+    Message() : stamp(0) {
+    }
+    explicit Message(int s) : stamp(s) {
+    }
+    int stamp;
+    char body[252] = {};
+};
+
+/// Construct an empty list of heavy payloads and put a few elements into it.
+void ConstructSparse(benchmark::State& state) {
+    for (auto _ : state) {
+        cdt::ArrayList<Message, 1024> l;
+        l.emplace_back(1);
+        l.emplace_back(2);
+        benchmark::DoNotOptimize(&l);
+    }
+}
+BENCHMARK(ConstructSparse);
+} // namespace
+
+BENCHMARK_MAIN();
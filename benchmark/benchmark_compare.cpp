@@ -0,0 +1,234 @@
+#include <array_list/arraylist.hpp>
+#include <array_list/fixedvector.hpp>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "benchmark/benchmark.h"
+
+/// Compares the containers of this library with the standard containers for the same basic operations,
+/// across capacities, fill levels and payload sizes. Each benchmark is named
+/// <Operation>/<container>/<payload>/<capacity>, the argument is the fill level in percent of the capacity.
+
+namespace {
+
+/// Payload of 4 bytes
+typedef int32_t Small;
+
+/// Payload of 64 bytes, one cache line
+struct Large {
+    Large() : data(){};
+    Large(int32_t v) : data() {
+        data[0] = v;
+    }
+    int32_t key() const {
+        return data[0];
+    }
+    int32_t data[16];
+};
+
+int32_t key(Small x) {
+    return x;
+}
+int32_t key(const Large& x) {
+    return x.key();
+}
+
+// Containers under comparison, together with the operations they support:
+struct ArrayListKind {
+    static constexpr const char* name = "ArrayList";
+    template <typename _Tp, size_t _N>
+    using type = cdt::ArrayList<_Tp, _N>;
+    static constexpr bool has_insert = true;
+    static constexpr bool has_index = true;
+};
+struct FixedVectorKind {
+    static constexpr const char* name = "FixedVector";
+    template <typename _Tp, size_t _N>
+    using type = cdt::FixedVector<_Tp, _N>;
+    static constexpr bool has_insert = false; // Only appends
+    static constexpr bool has_index = true;
+};
+struct VectorKind {
+    static constexpr const char* name = "std::vector";
+    template <typename _Tp, size_t>
+    using type = std::vector<_Tp>;
+    static constexpr bool has_insert = true;
+    static constexpr bool has_index = true;
+};
+struct ListKind {
+    static constexpr const char* name = "std::list";
+    template <typename _Tp, size_t>
+    using type = std::list<_Tp>;
+    static constexpr bool has_insert = true;
+    static constexpr bool has_index = false;
+};
+struct DequeKind {
+    static constexpr const char* name = "std::deque";
+    template <typename _Tp, size_t>
+    using type = std::deque<_Tp>;
+    static constexpr bool has_insert = true;
+    static constexpr bool has_index = true;
+};
+
+/// Containers are allocated on the heap, since the fixed containers of the larger capacities exceed the stack.
+/// std::vector reserves its capacity up front, which matches the fixed containers.
+template <typename _Container>
+void reserve(_Container&, size_t) {}
+template <typename _Tp>
+void reserve(std::vector<_Tp>& c, size_t n) {
+    c.reserve(n);
+}
+template <typename _Container>
+std::unique_ptr<_Container> make_filled(size_t capacity, int64_t percent) {
+    std::unique_ptr<_Container> c(new _Container());
+    reserve(*c, capacity);
+    const size_t n = capacity * percent / 100;
+    for (size_t i = 0; i < n; i++) {
+        c->push_back(static_cast<int32_t>(i));
+    }
+    return c;
+}
+
+/// Push and pop one element at the back
+template <typename _Container>
+void PushPop(benchmark::State& state, size_t capacity) {
+    auto c = make_filled<_Container>(capacity, state.range(0));
+    if (c->size() == capacity) {
+        c->pop_back();
+    }
+    for (auto _ : state) {
+        c->push_back(1);
+        c->pop_back();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// Insert and erase one element in the middle, the position is looked up once
+template <typename _Container>
+void InsertErase(benchmark::State& state, size_t capacity) {
+    auto c = make_filled<_Container>(capacity, state.range(0));
+    if (c->size() == capacity) {
+        c->pop_back();
+    }
+    auto it = std::next(c->begin(), c->size() / 2);
+    for (auto _ : state) {
+        it = c->insert(it, 1);
+        it = c->erase(it);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// Visit all elements in order
+template <typename _Container>
+void Iterate(benchmark::State& state, size_t capacity) {
+    auto c = make_filled<_Container>(capacity, state.range(0));
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (const auto& x : *c) {
+            sum += key(x);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * c->size());
+}
+
+/// Visit all elements by subscript
+template <typename _Container>
+void Index(benchmark::State& state, size_t capacity) {
+    auto c = make_filled<_Container>(capacity, state.range(0));
+    const size_t n = c->size();
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (size_t i = 0; i < n; i++) {
+            sum += key((*c)[i]);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+/// Fill up to the fill level and clear again
+template <typename _Container>
+void FillClear(benchmark::State& state, size_t capacity) {
+    std::unique_ptr<_Container> c(new _Container());
+    reserve(*c, capacity);
+    const size_t n = capacity * state.range(0) / 100;
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; i++) {
+            c->push_back(static_cast<int32_t>(i));
+        }
+        c->clear();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename _Container>
+void Register(const std::string& op, const std::string& kind, const std::string& payload, size_t capacity,
+              void (*fn)(benchmark::State&, size_t), bool with_empty) {
+    const std::string name = op + "/" + kind + "/" + payload + "/" + std::to_string(capacity);
+    auto* b = benchmark::RegisterBenchmark(name.c_str(), fn, capacity);
+    if (with_empty) {
+        b->Arg(0);
+    }
+    b->Arg(50)->Arg(100);
+}
+
+/// Operations, which not all containers support, are only instantiated for those that do
+template <typename _Container>
+void RegisterInsertErase(const std::string& kind, const std::string& payload, size_t capacity, std::true_type) {
+    Register<_Container>("InsertErase", kind, payload, capacity, &InsertErase<_Container>, true);
+}
+template <typename _Container>
+void RegisterInsertErase(const std::string&, const std::string&, size_t, std::false_type) {}
+template <typename _Container>
+void RegisterIndex(const std::string& kind, const std::string& payload, size_t capacity, std::true_type) {
+    Register<_Container>("Index", kind, payload, capacity, &Index<_Container>, false);
+}
+template <typename _Container>
+void RegisterIndex(const std::string&, const std::string&, size_t, std::false_type) {}
+
+template <typename _Kind, typename _Tp, size_t _N>
+void RegisterAll(const std::string& payload) {
+    typedef typename _Kind::template type<_Tp, _N> Container;
+    const std::string kind = _Kind::name;
+    Register<Container>("PushPop", kind, payload, _N, &PushPop<Container>, true);
+    RegisterInsertErase<Container>(kind, payload, _N, std::integral_constant<bool, _Kind::has_insert>());
+    Register<Container>("Iterate", kind, payload, _N, &Iterate<Container>, false);
+    RegisterIndex<Container>(kind, payload, _N, std::integral_constant<bool, _Kind::has_index>());
+    Register<Container>("FillClear", kind, payload, _N, &FillClear<Container>, false);
+}
+
+template <typename _Tp, size_t _N>
+void RegisterCapacity(const std::string& payload) {
+    RegisterAll<ArrayListKind, _Tp, _N>(payload);
+    RegisterAll<FixedVectorKind, _Tp, _N>(payload);
+    RegisterAll<VectorKind, _Tp, _N>(payload);
+    RegisterAll<ListKind, _Tp, _N>(payload);
+    RegisterAll<DequeKind, _Tp, _N>(payload);
+}
+
+template <typename _Tp>
+void RegisterPayload(const std::string& payload) {
+    RegisterCapacity<_Tp, 16>(payload);
+    RegisterCapacity<_Tp, 256>(payload);
+    RegisterCapacity<_Tp, 4096>(payload);
+    RegisterCapacity<_Tp, 65536>(payload);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    RegisterPayload<Small>("4B");
+    RegisterPayload<Large>("64B");
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
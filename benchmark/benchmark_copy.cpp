@@ -0,0 +1,89 @@
+#include <array_list/arraylist.hpp>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include "benchmark/benchmark.h"
+
+/// Copy, move and swap of ArrayList across fill ratios. The argument is the fill level in percent of the capacity.
+/// FullImage copies the whole object, like an implicitly defined copy constructor would, as reference.
+
+namespace {
+constexpr size_t capacity = 4096;
+typedef cdt::ArrayList<int32_t, capacity> List;
+
+/// List filled to percent of the capacity after some churn, so the list order does not match the slot order
+std::unique_ptr<List> make_list(int64_t percent) {
+    std::unique_ptr<List> l(new List());
+    const size_t n = capacity * percent / 100;
+    std::mt19937 rng(1);
+    for (size_t i = 0; i < n; i++) {
+        if (rng() % 2) {
+            l->push_front(static_cast<int32_t>(i));
+        } else {
+            l->push_back(static_cast<int32_t>(i));
+        }
+    }
+    return l;
+}
+
+void FullImage(benchmark::State& state) {
+    auto l = make_list(state.range(0));
+    std::unique_ptr<List> copy(new List());
+    for (auto _ : state) {
+        std::memcpy(static_cast<void*>(copy.get()), l.get(), sizeof(List));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * sizeof(List));
+}
+BENCHMARK(FullImage)->Arg(1)->Arg(10)->Arg(50)->Arg(100);
+
+void Copy(benchmark::State& state) {
+    auto l = make_list(state.range(0));
+    std::unique_ptr<List> copy(new List());
+    for (auto _ : state) {
+        *copy = *l;
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * l->size());
+}
+BENCHMARK(Copy)->Arg(1)->Arg(10)->Arg(50)->Arg(100);
+
+void AssignCompacted(benchmark::State& state) {
+    auto l = make_list(state.range(0));
+    std::unique_ptr<List> copy(new List());
+    for (auto _ : state) {
+        copy->assign_compacted(*l);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * l->size());
+}
+BENCHMARK(AssignCompacted)->Arg(1)->Arg(10)->Arg(50)->Arg(100);
+
+/// Moves back and forth, so both lists keep their size
+void Move(benchmark::State& state) {
+    auto a = make_list(state.range(0));
+    std::unique_ptr<List> b(new List());
+    for (auto _ : state) {
+        *b = std::move(*a);
+        *a = std::move(*b);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * a->size());
+}
+BENCHMARK(Move)->Arg(1)->Arg(10)->Arg(50)->Arg(100);
+
+/// Swap with a list of half the size
+void Swap(benchmark::State& state) {
+    auto a = make_list(state.range(0));
+    auto b = make_list(state.range(0) / 2);
+    for (auto _ : state) {
+        a->swap(*b);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * (a->size() + b->size()));
+}
+BENCHMARK(Swap)->Arg(1)->Arg(10)->Arg(50)->Arg(100);
+} // namespace
+
+BENCHMARK_MAIN();
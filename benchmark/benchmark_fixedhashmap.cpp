@@ -0,0 +1,156 @@
+#include <array_list/fixedhashmap.hpp>
+#include <array_list/fixedvector.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "benchmark/benchmark.h"
+
+/// Compares FixedHashMap with std::unordered_map and with a FixedVector of pairs, which is searched linearly.
+/// Every map holds capacity / 2 random keys. Benchmarks are named <Operation>_<container>/<capacity>.
+
+namespace {
+typedef uint32_t Key;
+typedef int32_t Value;
+
+/// Bounded map on top of a FixedVector, as used before FixedHashMap
+template <size_t _N>
+struct LinearMap {
+    typedef std::pair<Key, Value> Entry;
+    const Value* find(Key key) const {
+        const Entry* e = find_entry(key);
+        return e != v.end() ? &e->second : nullptr;
+    }
+    void insert(Key key, Value value) {
+        if (find_entry(key) == v.end()) {
+            v.push_back(Entry(key, value));
+        }
+    }
+    void erase(Key key) {
+        const Entry* e = find_entry(key);
+        if (e != v.end()) {
+            v.erase(const_cast<Entry*>(e));
+        }
+    }
+    const Entry* find_entry(Key key) const {
+        return std::find_if(v.begin(), v.end(), [key](const Entry& e) { return e.first == key; });
+    }
+    cdt::FixedVector<Entry, _N> v;
+};
+
+template <size_t _N>
+struct Hash {
+    const Value* find(Key key) const {
+        auto it = m.find(key);
+        return it != m.end() ? &it->second : nullptr;
+    }
+    void insert(Key key, Value value) {
+        m.insert(std::make_pair(key, value));
+    }
+    void erase(Key key) {
+        m.erase(key);
+    }
+    cdt::FixedHashMap<Key, Value, _N> m;
+};
+
+template <size_t _N>
+struct Unordered {
+    Unordered() {
+        m.reserve(_N);
+    }
+    const Value* find(Key key) const {
+        auto it = m.find(key);
+        return it != m.end() ? &it->second : nullptr;
+    }
+    void insert(Key key, Value value) {
+        m.insert(std::make_pair(key, value));
+    }
+    void erase(Key key) {
+        m.erase(key);
+    }
+    std::unordered_map<Key, Value> m;
+};
+
+/// capacity / 2 random keys in random order, inserted into map
+template <typename _Map, size_t _N>
+std::vector<Key> fill(_Map& map) {
+    std::mt19937 rng(1);
+    std::vector<Key> keys;
+    while (keys.size() < _N / 2) {
+        const Key key = rng();
+        if (!map.find(key)) {
+            map.insert(key, static_cast<Value>(keys.size()));
+            keys.push_back(key);
+        }
+    }
+    return keys;
+}
+
+template <template <size_t> class _Map, size_t _N>
+void FindHit(benchmark::State& state) {
+    std::unique_ptr<_Map<_N>> map(new _Map<_N>());
+    const std::vector<Key> keys = fill<_Map<_N>, _N>(*map);
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (Key key : keys) {
+            sum += *map->find(key);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <template <size_t> class _Map, size_t _N>
+void FindMiss(benchmark::State& state) {
+    std::unique_ptr<_Map<_N>> map(new _Map<_N>());
+    std::vector<Key> keys = fill<_Map<_N>, _N>(*map);
+    for (Key& key : keys) {
+        key = ~key; // Random keys, which are missing with high probability
+    }
+    for (auto _ : state) {
+        int64_t found = 0;
+        for (Key key : keys) {
+            found += map->find(key) != nullptr;
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+/// Erase a key and insert a new one, the size stays at capacity / 2
+template <template <size_t> class _Map, size_t _N>
+void Churn(benchmark::State& state) {
+    std::unique_ptr<_Map<_N>> map(new _Map<_N>());
+    std::vector<Key> keys = fill<_Map<_N>, _N>(*map);
+    std::mt19937 rng(2);
+    size_t k = 0;
+    for (auto _ : state) {
+        const Key key = rng();
+        map->erase(keys[k]);
+        map->insert(key, 0);
+        keys[k] = key;
+        k = k + 1 < keys.size() ? k + 1 : 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define CDT_HASHMAP_BENCHMARKS(capacity)                                                                               \
+    BENCHMARK_TEMPLATE(FindHit, Hash, capacity)->Name("FindHit_FixedHashMap/" #capacity);                              \
+    BENCHMARK_TEMPLATE(FindHit, Unordered, capacity)->Name("FindHit_UnorderedMap/" #capacity);                         \
+    BENCHMARK_TEMPLATE(FindHit, LinearMap, capacity)->Name("FindHit_FixedVector/" #capacity);                          \
+    BENCHMARK_TEMPLATE(FindMiss, Hash, capacity)->Name("FindMiss_FixedHashMap/" #capacity);                            \
+    BENCHMARK_TEMPLATE(FindMiss, Unordered, capacity)->Name("FindMiss_UnorderedMap/" #capacity);                       \
+    BENCHMARK_TEMPLATE(FindMiss, LinearMap, capacity)->Name("FindMiss_FixedVector/" #capacity);                        \
+    BENCHMARK_TEMPLATE(Churn, Hash, capacity)->Name("Churn_FixedHashMap/" #capacity);                                  \
+    BENCHMARK_TEMPLATE(Churn, Unordered, capacity)->Name("Churn_UnorderedMap/" #capacity);                             \
+    BENCHMARK_TEMPLATE(Churn, LinearMap, capacity)->Name("Churn_FixedVector/" #capacity)
+
+CDT_HASHMAP_BENCHMARKS(16);
+CDT_HASHMAP_BENCHMARKS(256);
+CDT_HASHMAP_BENCHMARKS(4096);
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,147 @@
+#include <array_list/fixedpriorityqueue.hpp>
+#include <array_list/fixedvector.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <vector>
+#include "benchmark/benchmark.h"
+
+/// A timer scheduler with a fixed number of timers: every tick fires the earliest deadline and rearms it,
+/// and timers are rescheduled in between. Compares FixedPriorityQueue with a rescan of a FixedVector
+/// and with std::priority_queue, which cannot change an element in place.
+
+namespace {
+typedef uint64_t Deadline;
+
+/// Deadlines in a FixedVector, the earliest one is searched on every tick. A timer is its index.
+template <size_t _N>
+struct Scan {
+    typedef size_t Timer;
+    Timer add(Deadline d) {
+        v.push_back(d);
+        return v.size() - 1;
+    }
+    Deadline fire_and_rearm(Deadline delay) {
+        Deadline* earliest = v.min_element();
+        const Deadline now = *earliest;
+        *earliest = now + delay;
+        return now;
+    }
+    void reschedule(Timer t, Deadline d) {
+        v[t] = d;
+    }
+    Deadline earliest() const {
+        return *v.min_element();
+    }
+    cdt::FixedVector<Deadline, _N> v;
+};
+
+template <size_t _N>
+struct Heap {
+    typedef cdt::FixedPriorityQueue<Deadline, _N, std::greater<Deadline>> Queue;
+    typedef typename Queue::Handle Timer;
+    Timer add(Deadline d) {
+        return q.push(d);
+    }
+    Deadline fire_and_rearm(Deadline delay) {
+        const Deadline now = q.top();
+        q.update(q.top_handle(), now + delay);
+        return now;
+    }
+    void reschedule(Timer t, Deadline d) {
+        q.update(t, d);
+    }
+    Deadline earliest() const {
+        return q.top();
+    }
+    Queue q;
+};
+
+/// Only supports firing, rescheduling would need a search
+template <size_t _N>
+struct StdHeap {
+    typedef size_t Timer;
+    Timer add(Deadline d) {
+        q.push(d);
+        return 0;
+    }
+    Deadline fire_and_rearm(Deadline delay) {
+        const Deadline now = q.top();
+        q.pop();
+        q.push(now + delay);
+        return now;
+    }
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> q;
+};
+
+/// _N timers with random deadlines
+template <typename _Scheduler, size_t _N>
+std::unique_ptr<_Scheduler> make_scheduler(std::vector<typename _Scheduler::Timer>& timers) {
+    std::unique_ptr<_Scheduler> s(new _Scheduler());
+    std::mt19937 rng(1);
+    for (size_t i = 0; i < _N; i++) {
+        timers.push_back(s->add(rng() % 100000));
+    }
+    return s;
+}
+
+/// Random delays, precomputed so that the generator is not measured
+std::vector<Deadline> make_delays() {
+    std::vector<Deadline> delays(1024);
+    std::mt19937 rng(2);
+    for (Deadline& d : delays) {
+        d = 1 + rng() % 100000;
+    }
+    return delays;
+}
+
+/// Fire the earliest timer and rearm it with a random delay
+template <typename _Scheduler, size_t _N>
+void Tick(benchmark::State& state) {
+    std::vector<typename _Scheduler::Timer> timers;
+    auto s = make_scheduler<_Scheduler, _N>(timers);
+    const std::vector<Deadline> delays = make_delays();
+    size_t k = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(s->fire_and_rearm(delays[k++ % delays.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// Move a random timer to a new deadline, then look up the earliest one
+template <typename _Scheduler, size_t _N>
+void Reschedule(benchmark::State& state) {
+    std::vector<typename _Scheduler::Timer> timers;
+    auto s = make_scheduler<_Scheduler, _N>(timers);
+    const std::vector<Deadline> delays = make_delays();
+    std::mt19937 rng(3);
+    std::vector<size_t> picks(1024);
+    for (size_t& p : picks) {
+        p = rng() % _N;
+    }
+    size_t k = 0;
+    Deadline now = 0;
+    for (auto _ : state) {
+        s->reschedule(timers[picks[k % picks.size()]], now + delays[k % delays.size()]);
+        now = s->earliest();
+        benchmark::DoNotOptimize(now);
+        k++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define CDT_SCHEDULER_BENCHMARKS(capacity)                                                                         \
+    BENCHMARK_TEMPLATE(Tick, Heap<capacity>, capacity)->Name("Tick_FixedPriorityQueue/" #capacity);                \
+    BENCHMARK_TEMPLATE(Tick, Scan<capacity>, capacity)->Name("Tick_FixedVector/" #capacity);                       \
+    BENCHMARK_TEMPLATE(Tick, StdHeap<capacity>, capacity)->Name("Tick_PriorityQueue/" #capacity);                  \
+    BENCHMARK_TEMPLATE(Reschedule, Heap<capacity>, capacity)->Name("Reschedule_FixedPriorityQueue/" #capacity);    \
+    BENCHMARK_TEMPLATE(Reschedule, Scan<capacity>, capacity)->Name("Reschedule_FixedVector/" #capacity)
+
+CDT_SCHEDULER_BENCHMARKS(16);
+CDT_SCHEDULER_BENCHMARKS(256);
+CDT_SCHEDULER_BENCHMARKS(4096);
+} // namespace
+
+BENCHMARK_MAIN();
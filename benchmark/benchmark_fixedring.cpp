@@ -0,0 +1,134 @@
+#include <array_list/fixedring.hpp>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "benchmark/benchmark.h"
+
+namespace {
+constexpr size_t capacity = 1024;
+constexpr int items = 1 << 16;
+
+/// Mutex protected std::deque with the same interface, as reference.
+template <typename _Tp>
+class LockedDeque {
+public:
+    bool try_push(const _Tp& x) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.size() >= capacity) {
+            return false;
+        }
+        queue.push_back(x);
+        return true;
+    }
+    bool try_pop(_Tp& x) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty()) {
+            return false;
+        }
+        x = queue.front();
+        queue.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex mutex;
+    std::deque<_Tp> queue;
+};
+
+/// Pass items from a producer thread to the benchmark thread.
+template <typename _Queue>
+void Throughput(benchmark::State& state) {
+    for (auto _ : state) {
+        _Queue q;
+        std::thread producer([&q]() {
+            for (int i = 0; i < items;) {
+                if (q.try_push(i)) {
+                    ++i;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        long sum = 0;
+        for (int i = 0; i < items;) {
+            int x;
+            if (q.try_pop(x)) {
+                sum += x;
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * items);
+}
+BENCHMARK_TEMPLATE(Throughput, cdt::FixedRing<int, capacity>)->UseRealTime();
+BENCHMARK_TEMPLATE(Throughput, LockedDeque<int>)->UseRealTime();
+
+/// Pass items in batches from a producer thread to the benchmark thread.
+void ThroughputBatched(benchmark::State& state) {
+    const size_t batch = state.range(0);
+    for (auto _ : state) {
+        cdt::FixedRing<int, capacity> q;
+        std::thread producer([&q, batch]() {
+            std::vector<int> in(batch, 1);
+            for (int i = 0; i < items;) {
+                size_t n = q.push_n(in.begin(), std::min<size_t>(batch, items - i));
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+                i += n;
+            }
+        });
+        std::vector<int> out(batch);
+        for (int i = 0; i < items;) {
+            size_t n = q.pop_n(out.begin(), batch);
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+            i += n;
+        }
+        producer.join();
+    }
+    state.SetItemsProcessed(state.iterations() * items);
+}
+BENCHMARK(ThroughputBatched)->Arg(16)->Arg(256)->UseRealTime();
+
+/// Round trip of a single item through two queues, between the benchmark thread and an echo thread.
+template <typename _Queue>
+void RoundTripLatency(benchmark::State& state) {
+    _Queue request;
+    _Queue response;
+    std::atomic<bool> running(true);
+    std::thread echo([&]() {
+        int x;
+        while (running.load(std::memory_order_relaxed)) {
+            if (request.try_pop(x)) {
+                while (!response.try_push(x)) {
+                }
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    int x = 0;
+    for (auto _ : state) {
+        while (!request.try_push(x)) {
+        }
+        while (!response.try_pop(x)) {
+            std::this_thread::yield();
+        }
+    }
+    running = false;
+    echo.join();
+}
+BENCHMARK_TEMPLATE(RoundTripLatency, cdt::FixedRing<int, capacity>)->UseRealTime();
+BENCHMARK_TEMPLATE(RoundTripLatency, LockedDeque<int>)->UseRealTime();
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,152 @@
+#include <array_list/fixedvector.hpp>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include "benchmark/benchmark.h"
+
+namespace {
+constexpr size_t capacity = 1 << 14;
+
+typedef cdt::FixedVector<int32_t, capacity> Vector;
+
+/// Vector filled with random values from [0, range)
+std::unique_ptr<Vector> make_vector(size_t n, int32_t range) {
+    std::unique_ptr<Vector> v(new Vector());
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int32_t> dist(0, range - 1);
+    for (size_t i = 0; i < n; i++) {
+        v->push_back(dist(rng));
+    }
+    return v;
+}
+} // namespace
+
+/// Search for a value, which is not contained, so the whole vector is scanned
+static void FindStd(benchmark::State& state) {
+    auto v = make_vector(state.range(0), 1000);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::find(v->begin(), v->end(), 1000));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(FindStd)->Range(64, capacity);
+
+static void FindKernel(benchmark::State& state) {
+    auto v = make_vector(state.range(0), 1000);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(v->find(1000));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(FindKernel)->Range(64, capacity);
+
+static void CountStd(benchmark::State& state) {
+    auto v = make_vector(state.range(0), 16);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::count(v->begin(), v->end(), 3));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(CountStd)->Range(64, capacity);
+
+static void CountKernel(benchmark::State& state) {
+    auto v = make_vector(state.range(0), 16);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(v->count(3));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(CountKernel)->Range(64, capacity);
+
+static void MinElementStd(benchmark::State& state) {
+    auto v = make_vector(state.range(0), 1 << 30);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::min_element(v->begin(), v->end()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(MinElementStd)->Range(64, capacity);
+
+static void MinElementKernel(benchmark::State& state) {
+    auto v = make_vector(state.range(0), 1 << 30);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(v->min_element());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(MinElementKernel)->Range(64, capacity);
+
+/// Remove half of the elements at random, which defeats the branch predictor of a naive loop
+static void RemoveStd(benchmark::State& state) {
+    auto original = make_vector(state.range(0), 2);
+    std::unique_ptr<Vector> v(new Vector());
+    for (auto _ : state) {
+        state.PauseTiming();
+        *v = *original;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(std::remove(v->begin(), v->end(), 1));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(RemoveStd)->Range(1 << 10, capacity);
+
+static void RemoveKernel(benchmark::State& state) {
+    auto original = make_vector(state.range(0), 2);
+    std::unique_ptr<Vector> v(new Vector());
+    for (auto _ : state) {
+        state.PauseTiming();
+        *v = *original;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(v->remove(1));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(RemoveKernel)->Range(1 << 10, capacity);
+
+static void EraseIfKernel(benchmark::State& state) {
+    auto original = make_vector(state.range(0), 2);
+    std::unique_ptr<Vector> v(new Vector());
+    for (auto _ : state) {
+        state.PauseTiming();
+        *v = *original;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(v->erase_if([](int32_t x) { return x == 1; }));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(EraseIfKernel)->Range(1 << 10, capacity);
+
+static void EraseIfUnorderedKernel(benchmark::State& state) {
+    auto original = make_vector(state.range(0), 2);
+    std::unique_ptr<Vector> v(new Vector());
+    for (auto _ : state) {
+        state.PauseTiming();
+        *v = *original;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(v->erase_if_unordered([](int32_t x) { return x == 1; }));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(EraseIfUnorderedKernel)->Range(1 << 10, capacity);
+
+/// Erase matching elements one by one, each erase() swaps in the last element
+static void EraseLoop(benchmark::State& state) {
+    auto original = make_vector(state.range(0), 2);
+    std::unique_ptr<Vector> v(new Vector());
+    for (auto _ : state) {
+        state.PauseTiming();
+        *v = *original;
+        state.ResumeTiming();
+        for (size_t i = 0; i < v->size();) {
+            if ((*v)[i] == 1) {
+                v->erase(i);
+            } else {
+                ++i;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(EraseLoop)->Range(1 << 10, capacity);
+
+BENCHMARK_MAIN();
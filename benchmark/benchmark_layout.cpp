@@ -0,0 +1,80 @@
+#include <array_list/arraylist.hpp>
+#include <iterator>
+#include "benchmark/benchmark.h"
+
+namespace {
+constexpr size_t capacity = 4096;
+
+/// Payload of configurable size, which carries a key in front.
+template <size_t _Size>
+struct Payload {
+    Payload(int k) : key(k) {
+    }
+    int key;
+    char body[_Size - sizeof(int)];
+};
+typedef Payload<8> Small;
+typedef Payload<256> Large;
+
+/// Fill a list, alternating between front and back, so that list order differs from slot order.
+template <typename _List>
+void fill(_List& l) {
+    for (size_t i = 0; i < capacity; i++) {
+        if (i % 2) {
+            l.emplace_back(i);
+        } else {
+            l.emplace_front(i);
+        }
+    }
+}
+
+/// Follow all links without touching the payloads.
+template <typename _Tp, typename _Layout>
+void WalkLinks(benchmark::State& state) {
+    cdt::ArrayList<_Tp, capacity, _Layout> l;
+    fill(l);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::distance(l.begin(), l.end()));
+    }
+    state.SetItemsProcessed(state.iterations() * capacity);
+}
+BENCHMARK_TEMPLATE(WalkLinks, Small, cdt::InterleavedLayout);
+BENCHMARK_TEMPLATE(WalkLinks, Small, cdt::SplitLayout);
+BENCHMARK_TEMPLATE(WalkLinks, Large, cdt::InterleavedLayout);
+BENCHMARK_TEMPLATE(WalkLinks, Large, cdt::SplitLayout);
+
+/// Step to the last element by subscript.
+template <typename _Tp, typename _Layout>
+void SubscriptLast(benchmark::State& state) {
+    cdt::ArrayList<_Tp, capacity, _Layout> l;
+    fill(l);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(l[capacity - 1].key);
+    }
+}
+BENCHMARK_TEMPLATE(SubscriptLast, Small, cdt::InterleavedLayout);
+BENCHMARK_TEMPLATE(SubscriptLast, Small, cdt::SplitLayout);
+BENCHMARK_TEMPLATE(SubscriptLast, Large, cdt::InterleavedLayout);
+BENCHMARK_TEMPLATE(SubscriptLast, Large, cdt::SplitLayout);
+
+/// Visit every element and read its key.
+template <typename _Tp, typename _Layout>
+void IterateKeys(benchmark::State& state) {
+    cdt::ArrayList<_Tp, capacity, _Layout> l;
+    fill(l);
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto it = l.begin(); it != l.end(); ++it) {
+            sum += it->key;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * capacity);
+}
+BENCHMARK_TEMPLATE(IterateKeys, Small, cdt::InterleavedLayout);
+BENCHMARK_TEMPLATE(IterateKeys, Small, cdt::SplitLayout);
+BENCHMARK_TEMPLATE(IterateKeys, Large, cdt::InterleavedLayout);
+BENCHMARK_TEMPLATE(IterateKeys, Large, cdt::SplitLayout);
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,157 @@
+#include <array_list/arraylist.hpp>
+#include <array_list/slotmap.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "benchmark/benchmark.h"
+
+/// Compares SlotMap with the usual alternatives for stable references:
+/// ArrayList iterators and an unordered_map from ids to values.
+
+namespace {
+constexpr size_t capacity = 4096;
+typedef cdt::SlotMap<int32_t, capacity> Map;
+
+/// Half full map, after a random erase pattern, so that handles and values are scattered
+std::unique_ptr<Map> make_map(std::vector<Map::Handle>& handles) {
+    std::unique_ptr<Map> m(new Map());
+    for (size_t i = 0; i < capacity; i++) {
+        handles.push_back(m->insert(static_cast<int32_t>(i)));
+    }
+    std::mt19937 rng(1);
+    std::shuffle(handles.begin(), handles.end(), rng);
+    for (size_t i = capacity / 2; i < capacity; i++) {
+        m->erase(handles[i]);
+    }
+    handles.resize(capacity / 2);
+    return m;
+}
+
+/// Resolve stored handles in random order
+void Lookup_SlotMap(benchmark::State& state) {
+    std::vector<Map::Handle> handles;
+    auto m = make_map(handles);
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (auto h : handles) {
+            sum += (*m)[h];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * handles.size());
+}
+BENCHMARK(Lookup_SlotMap);
+
+/// Same with a check for stale handles first
+void LookupChecked_SlotMap(benchmark::State& state) {
+    std::vector<Map::Handle> handles;
+    auto m = make_map(handles);
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (auto h : handles) {
+            if (const int32_t* p = m->find(h)) {
+                sum += *p;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * handles.size());
+}
+BENCHMARK(LookupChecked_SlotMap);
+
+void Lookup_UnorderedMap(benchmark::State& state) {
+    std::unordered_map<uint32_t, int32_t> m;
+    std::vector<uint32_t> ids;
+    for (uint32_t i = 0; i < capacity / 2; i++) {
+        m[i * 2654435761u] = i;
+        ids.push_back(i * 2654435761u);
+    }
+    std::mt19937 rng(1);
+    std::shuffle(ids.begin(), ids.end(), rng);
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (auto id : ids) {
+            sum += m.find(id)->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(Lookup_UnorderedMap);
+
+/// Visit all live elements
+void Iterate_SlotMap(benchmark::State& state) {
+    std::vector<Map::Handle> handles;
+    auto m = make_map(handles);
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (auto x : *m) {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * m->size());
+}
+BENCHMARK(Iterate_SlotMap);
+
+void Iterate_ArrayList(benchmark::State& state) {
+    typedef cdt::ArrayList<int32_t, capacity> List;
+    std::unique_ptr<List> l(new List());
+    std::vector<List::iterator> its;
+    for (size_t i = 0; i < capacity; i++) {
+        its.push_back(l->insert(l->end(), static_cast<int32_t>(i)));
+    }
+    std::mt19937 rng(1);
+    std::shuffle(its.begin(), its.end(), rng);
+    for (size_t i = capacity / 2; i < capacity; i++) {
+        l->erase(its[i]);
+    }
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (auto x : *l) {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * l->size());
+}
+BENCHMARK(Iterate_ArrayList);
+
+/// Erase a random live element and insert a new one
+void Churn_SlotMap(benchmark::State& state) {
+    std::vector<Map::Handle> handles;
+    auto m = make_map(handles);
+    size_t i = 0;
+    for (auto _ : state) {
+        m->erase(handles[i]);
+        handles[i] = m->insert(1);
+        i = (i + 1) % handles.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Churn_SlotMap);
+
+void Churn_UnorderedMap(benchmark::State& state) {
+    std::unordered_map<uint32_t, int32_t> m;
+    std::vector<uint32_t> ids;
+    for (uint32_t i = 0; i < capacity / 2; i++) {
+        m[i] = i;
+        ids.push_back(i);
+    }
+    uint32_t next = capacity / 2;
+    size_t i = 0;
+    for (auto _ : state) {
+        m.erase(ids[i]);
+        m[next] = 1;
+        ids[i] = next++;
+        i = (i + 1) % ids.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Churn_UnorderedMap);
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,68 @@
+#include <array_list/slotpool.hpp>
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+#include "benchmark/benchmark.h"
+
+namespace {
+constexpr size_t capacity = 4096;
+const int max_threads = std::max(4u, std::thread::hardware_concurrency());
+
+/// Mutex protected free stack with the same interface, as reference.
+class LockedSlotPool {
+public:
+    typedef size_t position_type;
+    LockedSlotPool() {
+        for (size_t i = capacity; i > 0; i--) {
+            free.push_back(i - 1);
+        }
+    }
+    bool try_allocate(position_type& i) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (free.empty()) {
+            return false;
+        }
+        i = free.back();
+        free.pop_back();
+        return true;
+    }
+    void deallocate(position_type i) {
+        std::lock_guard<std::mutex> lock(mutex);
+        free.push_back(i);
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<size_t> free;
+};
+
+/// Every thread repeatedly acquires a handful of slots from one shared pool and releases them again.
+/// The pool is constructed in static storage, since new does not honor its cache line alignment before C++17.
+template <typename _Pool>
+void AllocateDeallocate(benchmark::State& state) {
+    alignas(_Pool) static unsigned char storage[sizeof(_Pool)];
+    static _Pool* pool;
+    if (state.thread_index() == 0) {
+        pool = new (storage) _Pool();
+    }
+    typename _Pool::position_type held[4];
+    for (auto _ : state) {
+        for (auto& h : held) {
+            pool->try_allocate(h);
+        }
+        for (auto h : held) {
+            pool->deallocate(h);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 4);
+    if (state.thread_index() == 0) {
+        pool->~_Pool();
+    }
+}
+BENCHMARK_TEMPLATE(AllocateDeallocate, cdt::ConcurrentSlotPool<capacity>)->ThreadRange(1, max_threads)->UseRealTime();
+BENCHMARK_TEMPLATE(AllocateDeallocate, LockedSlotPool)->ThreadRange(1, max_threads)->UseRealTime();
+} // namespace
+
+BENCHMARK_MAIN();
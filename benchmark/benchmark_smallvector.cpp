@@ -0,0 +1,74 @@
+#include <array_list/fixedvector.hpp>
+#include <array_list/smallvector.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "benchmark/benchmark.h"
+
+/// Many small buffers, which usually hold a few elements and rarely a burst of many:
+/// a FixedVector sized for the bursts, a SmallVector sized for the common case, which spills during bursts,
+/// and std::vector. Every round refills all buffers and sums them up.
+/// The argument is the number of buffers, the larger pool only fits into the cache with small buffers.
+
+namespace {
+constexpr size_t burst = 64;
+
+/// Elements per buffer and round: mostly 1 to 4, one in 100 a burst
+std::vector<size_t> make_fills(size_t buffers) {
+    std::vector<size_t> fills(buffers * 8);
+    std::mt19937 rng(1);
+    for (size_t& f : fills) {
+        f = rng() % 100 == 0 ? burst : 1 + rng() % 4;
+    }
+    return fills;
+}
+
+/// Buffers, which return to the inline storage after a burst
+template <size_t _N>
+struct Small : cdt::SmallVector<int32_t, _N> {
+    void reset() {
+        this->clear();
+        this->shrink_to_fit();
+    }
+};
+struct Fixed : cdt::FixedVector<int32_t, burst> {
+    void reset() {
+        this->clear();
+    }
+};
+struct Std : std::vector<int32_t> {
+    void reset() {
+        this->clear();
+    }
+};
+
+template <typename _Buffer>
+void Refill(benchmark::State& state) {
+    const size_t buffers = state.range(0);
+    std::vector<_Buffer> pool(buffers);
+    const std::vector<size_t> fills = make_fills(buffers);
+    size_t k = 0;
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (_Buffer& b : pool) {
+            b.reset();
+            const size_t fill = fills[k++ % fills.size()];
+            for (size_t i = 0; i < fill; i++) {
+                b.push_back(static_cast<int32_t>(i));
+            }
+            for (int32_t x : b) {
+                sum += x;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * buffers);
+    state.counters["bytes_per_buffer"] = sizeof(_Buffer);
+}
+BENCHMARK_TEMPLATE(Refill, Small<4>)->Name("Refill_SmallVector4")->Arg(1024)->Arg(65536);
+BENCHMARK_TEMPLATE(Refill, Small<8>)->Name("Refill_SmallVector8")->Arg(1024)->Arg(65536);
+BENCHMARK_TEMPLATE(Refill, Fixed)->Name("Refill_FixedVector64")->Arg(1024)->Arg(65536);
+BENCHMARK_TEMPLATE(Refill, Std)->Name("Refill_StdVector")->Arg(1024)->Arg(65536);
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,90 @@
+#include <array_list/arraylist.hpp>
+#include <algorithm>
+#include <list>
+#include <random>
+#include <vector>
+#include "benchmark/benchmark.h"
+
+namespace {
+constexpr size_t capacity = 4096;
+
+/// Payload of configurable size, which is sorted by its key.
+template <size_t _Size>
+struct Payload {
+    Payload(int k) : key(k) {
+    }
+    bool operator<(const Payload& other) const {
+        return key < other.key;
+    }
+    int key;
+    char body[_Size - sizeof(int)];
+};
+typedef Payload<8> Small;
+typedef Payload<256> Large;
+
+std::vector<int> random_keys() {
+    std::vector<int> keys(capacity);
+    std::mt19937 rng(42);
+    for (auto& k : keys) {
+        k = rng();
+    }
+    return keys;
+}
+
+/// Member sort of ArrayList, which only rewrites links.
+template <typename _Tp>
+void ArrayListSort(benchmark::State& state) {
+    const std::vector<int> keys = random_keys();
+    cdt::ArrayList<_Tp, capacity, cdt::SplitLayout> l;
+    for (auto _ : state) {
+        state.PauseTiming();
+        l.assign(keys.begin(), keys.end());
+        state.ResumeTiming();
+        l.sort();
+        benchmark::DoNotOptimize(&l.front());
+    }
+    state.SetItemsProcessed(state.iterations() * capacity);
+}
+BENCHMARK_TEMPLATE(ArrayListSort, Small);
+BENCHMARK_TEMPLATE(ArrayListSort, Large);
+
+/// Member sort of std::list.
+template <typename _Tp>
+void StdListSort(benchmark::State& state) {
+    const std::vector<int> keys = random_keys();
+    std::list<_Tp> l;
+    for (auto _ : state) {
+        state.PauseTiming();
+        l.assign(keys.begin(), keys.end());
+        state.ResumeTiming();
+        l.sort();
+        benchmark::DoNotOptimize(&l.front());
+    }
+    state.SetItemsProcessed(state.iterations() * capacity);
+}
+BENCHMARK_TEMPLATE(StdListSort, Small);
+BENCHMARK_TEMPLATE(StdListSort, Large);
+
+/// Copy an ArrayList out to a vector, sort it and put it back, the way it had to be done before.
+template <typename _Tp>
+void CopySortReinsert(benchmark::State& state) {
+    const std::vector<int> keys = random_keys();
+    cdt::ArrayList<_Tp, capacity, cdt::SplitLayout> l;
+    std::vector<_Tp> buffer;
+    buffer.reserve(capacity);
+    for (auto _ : state) {
+        state.PauseTiming();
+        l.assign(keys.begin(), keys.end());
+        state.ResumeTiming();
+        buffer.assign(l.begin(), l.end());
+        std::stable_sort(buffer.begin(), buffer.end());
+        l.assign(buffer.begin(), buffer.end());
+        benchmark::DoNotOptimize(&l.front());
+    }
+    state.SetItemsProcessed(state.iterations() * capacity);
+}
+BENCHMARK_TEMPLATE(CopySortReinsert, Small);
+BENCHMARK_TEMPLATE(CopySortReinsert, Large);
+} // namespace
+
+BENCHMARK_MAIN();
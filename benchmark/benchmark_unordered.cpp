@@ -0,0 +1,63 @@
+#include <array_list/arraylist.hpp>
+#include <array_list/parallel.hpp>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include "benchmark/benchmark.h"
+
+/// Bulk update of every element of a shuffled ArrayList: in list order through the iterators, in slot order through
+/// the occupancy bitmap and in slot order on several threads. The argument is the number of elements before churn.
+
+namespace {
+constexpr size_t capacity = 1 << 20;
+typedef cdt::ArrayList<int64_t, capacity> List;
+
+/// List of about 3/4 n elements after some churn, so the list order jumps between slots and a quarter of them is free
+std::unique_ptr<List> make_list(int64_t n) {
+    std::unique_ptr<List> l(new List());
+    std::mt19937 rng(1);
+    for (int64_t i = 0; i < n; i++) {
+        if (rng() % 2) {
+            l->push_front(i);
+        } else {
+            l->push_back(i);
+        }
+    }
+    l->remove_if([&rng](int64_t) { return rng() % 4 == 0; });
+    return l;
+}
+
+void ListOrder(benchmark::State& state) {
+    auto l = make_list(state.range(0));
+    for (auto _ : state) {
+        for (int64_t& x : *l) {
+            x += 1;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * l->size());
+}
+BENCHMARK(ListOrder)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20);
+
+void SlotOrder(benchmark::State& state) {
+    auto l = make_list(state.range(0));
+    for (auto _ : state) {
+        l->for_each_unordered([](int64_t& x) { x += 1; });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * l->size());
+}
+BENCHMARK(SlotOrder)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20);
+
+void Parallel(benchmark::State& state) {
+    auto l = make_list(state.range(0));
+    for (auto _ : state) {
+        cdt::for_each_parallel(*l, [](int64_t& x) { x += 1; });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * l->size());
+}
+BENCHMARK(Parallel)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20)->UseRealTime();
+} // namespace
+
+BENCHMARK_MAIN();
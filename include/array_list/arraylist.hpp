@@ -1,135 +1,193 @@
 #pragma once
-#include <bitset>
+#include <algorithm>
+#include <array_list/detail/check_policy.hpp>
+#include <array_list/detail/compiler.hpp>
+#include <array_list/detail/constexpr.hpp>
+#include <array_list/detail/index_type.hpp>
+#include <array_list/detail/list_storage.hpp>
+#include <array_list/detail/snapshot.hpp>
+#include <array_list/detail/stats.hpp>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace cdt {
 
-template <typename _Tp, size_t _N>
-class ArrayList {
+/// \brief A doubly linked list on top of an array
+/// - supports insertion and deletion anywhere in constant time
+/// - preserves order
+/// - the _Layout (InterleavedLayout or SplitLayout) decides whether links and payloads share memory
+/// - records its usage, if CDT_ENABLE_STATS is set
+template <typename _Tp, size_t _N, typename _Layout = InterleavedLayout>
+class ArrayList : private detail::UsageRecorder {
 public:
     // types:
-    typedef ArrayList<_Tp, _N> list_type;
+    typedef ArrayList<_Tp, _N, _Layout> list_type;
     typedef _Tp value_type;
     typedef size_t size_type;
-    typedef size_t position_type;
-    typedef size_t difference_type;
+    typedef typename detail::MinimalIndex<_N>::type position_type; ///< Narrowest type able to address all slots
+    typedef std::ptrdiff_t difference_type;
     typedef _Tp* pointer;
+    typedef const _Tp* const_pointer;
     typedef _Tp& reference;
-    typedef const reference const_reference;
+    typedef const _Tp& const_reference;
 
 private:
-    struct NodeBase {
-        position_type next;
-        position_type prev;
-        NodeBase() : next(_N), prev(_N){};
-    };
-
-    struct Node : NodeBase {
-        template <typename... _Args>
-        Node(_Args&&... __args)
-                : data(std::forward<_Args>(__args)...) // Initialize idx as invalid
-                  {};
-        value_type data;
-    };
-    typedef Node node_type;
+    typedef detail::ListStorage<value_type, _N, position_type, _Layout> storage_type;
 
     class ListIterator {
         friend ArrayList;
 
     public:
-        ListIterator(node_type* start, position_type offset) : m_start(start), m_offset(offset) {
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef _Tp value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef _Tp* pointer;
+        typedef _Tp& reference;
+
+        CDT_CONSTEXPR ListIterator(storage_type* start, position_type offset) : m_start(start), m_offset(offset) {
         }
 
-        reference operator*() const {
-            if(m_offset >= _N){
-                throw std::out_of_range("Iterator is out of range.");
-            }
-            return (m_start + m_offset)->data;
+        CDT_CONSTEXPR reference operator*() const CDT_CHECK_NOEXCEPT {
+            detail::check<std::out_of_range>(m_offset < _N, "Iterator is out of range.");
+            return m_start->payload(m_offset).value;
         }
 
-        pointer operator->() const {
-            if(m_offset >= _N){
-                throw std::out_of_range("Iterator is out of range.");
-            }
-            return &(m_start + m_offset)->data;
+        CDT_CONSTEXPR pointer operator->() const CDT_CHECK_NOEXCEPT {
+            detail::check<std::out_of_range>(m_offset < _N, "Iterator is out of range.");
+            return &m_start->payload(m_offset).value;
         }
 
-        ListIterator& operator++() {
-            m_offset = get_node()->next;
+        CDT_CONSTEXPR ListIterator& operator++() noexcept {
+            m_offset = m_start->next(m_offset);
             return *this;
         }
 
-        ListIterator operator++(int) {
+        CDT_CONSTEXPR ListIterator operator++(int) noexcept {
             ListIterator __tmp = *this;
             ++*this;
             return __tmp;
         }
 
-        ListIterator& operator--() {
-            m_offset = get_node()->prev;
+        CDT_CONSTEXPR ListIterator& operator--() noexcept {
+            m_offset = m_start->prev(m_offset);
             return *this;
         }
 
-        ListIterator operator--(int) {
+        CDT_CONSTEXPR ListIterator operator--(int) noexcept {
             ListIterator __tmp = *this;
             --*this;
             return __tmp;
         }
 
-        bool operator==(const ListIterator& x) const {
+        CDT_CONSTEXPR bool operator==(const ListIterator& x) const noexcept {
             return (m_start == x.m_start && m_offset == x.m_offset);
         }
 
-        bool operator!=(const ListIterator& x) const {
+        CDT_CONSTEXPR bool operator!=(const ListIterator& x) const noexcept {
             return !(*this == x);
         }
 
     private:
-        node_type* get_node() const {
-            return (m_start + m_offset);
-        }
-
-        node_type* const m_start;
-        difference_type m_offset;
+        storage_type* m_start;
+        position_type m_offset;
     };
 
+    /// \brief Hands out and takes back slots of the node array in constant time.
+    /// Released slots are chained into a free list through their (now unused) next links.
+    /// Slots that have never been handed out are taken from the untouched tail of the array,
+    /// so the free list does not need to be initialized up front.
+    /// The allocator keeps the occupancy bitmap of the storage up to date.
     class Allocator {
     public:
-        Allocator(){};
-        position_type allocate() {
-            if (index.all()) {
-                throw std::length_error("No space left in DLList.");
-            }
-            size_type i;
-            for (i = 0; i < this->max_size(); i++) {
-                if (!index.test(i)) {
-                    index.set(i, true);
-                    break;
-                }
+        CDT_CONSTEXPR Allocator() : free_head(_N), untouched(0), count(0){};
+        CDT_CONSTEXPR position_type allocate(storage_type& nodes) CDT_CHECK_NOEXCEPT {
+            detail::check<std::length_error>(count < _N, "No space left in DLList.");
+            position_type i;
+            if (free_head != _N) {
+                i = free_head;
+                free_head = nodes.next(i);
+                nodes.mark_used(i);
+            } else {
+                i = untouched++;
+                nodes.mark_fresh(i);
             }
+            ++count;
             return i;
         };
 
-        void deallocate(position_type i) {
-            index.set(i, false);
+        CDT_CONSTEXPR void deallocate(storage_type& nodes, position_type i) {
+            nodes.mark_free(i);
+            nodes.next(i) = free_head;
+            free_head = i;
+            --count;
+        }
+        /// Release n slots at once, which are already chained by their next links from first to last.
+        CDT_CONSTEXPR void deallocate_chain(storage_type& nodes, position_type first, position_type last, size_type n) {
+            for (position_type i = first; i != last; i = nodes.next(i)) {
+                nodes.mark_free(i);
+            }
+            nodes.mark_free(last);
+            nodes.next(last) = free_head;
+            free_head = first;
+            count -= n;
         }
-        size_type size() const {
-            return index.count();
+        CDT_CONSTEXPR size_type size() const {
+            return count;
         }
-        size_type max_size() const {
-            return index.size();
+        /// Number of slots, which have been handed out at least once
+        CDT_CONSTEXPR size_type watermark() const {
+            return untouched;
         }
-        bool empty() const {
-            return index.none();
+        /// Whether the next slot is taken from the free list
+        CDT_CONSTEXPR bool recycling() const {
+            return free_head != _N;
         }
-        void clear() {
-            index.reset();
+        CDT_CONSTEXPR size_type max_size() const {
+            return _N;
+        }
+        CDT_CONSTEXPR bool empty() const {
+            return count == 0;
+        }
+        CDT_CONSTEXPR void clear() {
+            free_head = _N;
+            untouched = 0;
+            count = 0;
             return;
         }
+        /// Take over a packed state, where exactly the slots 0..n-1 are in use
+        CDT_CONSTEXPR void reset_packed(storage_type& nodes, size_type n) {
+            nodes.mark_packed(n);
+            free_head = _N;
+            untouched = n;
+            count = n;
+        }
+        /// Record the state in a snapshot header, respectively take it over from one
+        void save(SnapshotHeader& header) const {
+            header.size = count;
+            header.free_head = free_head;
+            header.untouched = untouched;
+        }
+        void load(const SnapshotHeader& header) {
+            detail::require<std::invalid_argument>(header.untouched <= _N && header.free_head <= _N &&
+                                                           header.size <= header.untouched,
+                                                   "Snapshot is corrupt.");
+            free_head = static_cast<position_type>(header.free_head);
+            untouched = static_cast<position_type>(header.untouched);
+            count = static_cast<position_type>(header.size);
+        }
 
     private:
-        std::bitset<_N> index;
+        position_type free_head; ///< First released slot, _N if there is none
+        position_type untouched; ///< Slots from here on have never been allocated
+        position_type count;
     };
 
 public:
@@ -139,163 +197,1094 @@ public:
     typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
 
     // construct/copy/destroy:
-    ArrayList(){};
+    CDT_CONSTEXPR ArrayList() : cursor_index(0) {
+        reset_sentinel();
+    };
+    // Copies and moves only touch the slots in use, never the whole capacity, see copy_from().
+    CDT_CONSTEXPR ArrayList(const ArrayList& other) : detail::UsageRecorder(), cursor_index(0) {
+        reset_sentinel();
+        copy_from(other, std::is_trivially_copyable<value_type>());
+    }
+    CDT_CONSTEXPR ArrayList(ArrayList&& other) : cursor_index(0) {
+        reset_sentinel();
+        move_from(other, std::is_trivially_copyable<value_type>());
+    }
+    CDT_CONSTEXPR ArrayList& operator=(const ArrayList& other) {
+        if (this != &other) {
+            this->clear();
+            copy_from(other, std::is_trivially_copyable<value_type>());
+        }
+        return *this;
+    }
+    CDT_CONSTEXPR ArrayList& operator=(ArrayList&& other) {
+        if (this != &other) {
+            this->clear();
+            move_from(other, std::is_trivially_copyable<value_type>());
+        }
+        return *this;
+    }
+    /// Copy the elements of other in list order into the slots 0..size()-1, so that this list is contiguous.
+    CDT_CONSTEXPR void assign_compacted(const list_type& other) {
+        if (this == &other) {
+            this->compact();
+            return;
+        }
+        this->clear();
+        fill_packed(other);
+    }
+    CDT_CONSTEXPR ~ArrayList() {
+        this->clear();
+    }
 
     // iterators:
-    iterator begin() {
-        return ListIterator(&data[0], data[_N].next);
+    CDT_CONSTEXPR iterator begin() noexcept {
+        return ListIterator(&data, data.next(_N));
     };
-    iterator end() {
-        return ListIterator(&data[0], _N);
+    CDT_CONSTEXPR iterator end() noexcept {
+        return ListIterator(&data, _N);
     };
 
-    // const_iterator begin() const;
-    // const_iterator end() const;
+    // const_iterator is a const iterator, it can not be advanced but still grants access to the element.
+    CDT_CONSTEXPR const_iterator begin() const noexcept {
+        return ListIterator(const_cast<storage_type*>(&data), data.next(_N));
+    };
+    CDT_CONSTEXPR const_iterator end() const noexcept {
+        return ListIterator(const_cast<storage_type*>(&data), _N);
+    };
+    CDT_CONSTEXPR const_iterator cbegin() const noexcept {
+        return begin();
+    };
+    CDT_CONSTEXPR const_iterator cend() const noexcept {
+        return end();
+    };
     // reverse_iterator rbegin();
     // const_reverse_iterator rbegin() const;
     // reverse_iterator rend();
     // const_reverse_iterator rend() const;
-    // const_iterator cbegin() const;
-    // const_iterator cend() const;
     // const_reverse_iterator crbegin() const;
     // const_reverse_iterator crend() const;
 
     // capacity:
-    size_type size() const {
+    CDT_CONSTEXPR size_type size() const noexcept {
         return this->allocator.size();
     };
-    size_type max_size() const {
+    CDT_CONSTEXPR size_type max_size() const noexcept {
         return this->allocator.max_size();
     };
-    bool empty() const {
+    CDT_CONSTEXPR bool empty() const noexcept {
         return this->allocator.empty();
     };
 
+    // statistics:
+    /// Usage recorded since construction or the last reset_stats(), all zero unless CDT_ENABLE_STATS is set
+    UsageStats stats() const noexcept {
+        return this->usage();
+    }
+    void reset_stats() noexcept {
+        this->reset_usage(size());
+    }
+
     // element access:
-    reference front() {
+    CDT_CONSTEXPR reference front() CDT_CHECK_NOEXCEPT {
         return *begin();
     }
-    const_reference front() const {
+    CDT_CONSTEXPR const_reference front() const CDT_CHECK_NOEXCEPT {
         return *begin();
     }
-    reference back() {
+    CDT_CONSTEXPR reference back() CDT_CHECK_NOEXCEPT {
         iterator __tmp = end();
         --__tmp;
         return *__tmp;
     }
-    const_reference back() const {
-        const_iterator __tmp = end();
+    CDT_CONSTEXPR const_reference back() const CDT_CHECK_NOEXCEPT {
+        iterator __tmp = end();
         --__tmp;
         return *__tmp;
     }
 
-    // Attention subscript operator does not provide have constant time acces
-    reference operator[](std::size_t idx) {
-        if (idx >= size()) {
-            throw std::out_of_range("Demanded idx is out of range.");
-        }
-        iterator it = begin();
-        for (size_t i = 0; i < idx; i++) {
-            it++;
-        }
-        return *it;
+    // Subscript access walks the links from the nearest of begin, end and the last accessed position.
+    // Sequential index loops are therefore linear overall, random access is still O(n).
+    // Only non-const access updates the cached position. Const access merely uses it, so concurrent readers of a
+    // const list do not race, as long as no usage statistics are recorded (CDT_ENABLE_STATS).
+    // operator[] is checked according to CDT_CHECK_POLICY, at() always throws on an invalid idx.
+    CDT_CONSTEXPR reference operator[](std::size_t idx) CDT_CHECK_NOEXCEPT {
+        detail::check<std::out_of_range>(idx < size(), "Demanded idx is out of range.");
+        return data.payload(seek(idx)).value;
+    }
+    CDT_CONSTEXPR const_reference operator[](std::size_t idx) const CDT_CHECK_NOEXCEPT {
+        detail::check<std::out_of_range>(idx < size(), "Demanded idx is out of range.");
+        return data.payload(slot_at(idx)).value;
     }
-    const_reference operator[](std::size_t idx) const {
-        if (idx > size()) {
-            throw std::out_of_range("Demanded idx is out of range.");
+    CDT_CONSTEXPR reference at(std::size_t idx) {
+        detail::require<std::out_of_range>(idx < size(), "Demanded idx is out of range.");
+        return data.payload(seek(idx)).value;
+    }
+    CDT_CONSTEXPR const_reference at(std::size_t idx) const {
+        detail::require<std::out_of_range>(idx < size(), "Demanded idx is out of range.");
+        return data.payload(slot_at(idx)).value;
+    }
+
+    // positional helpers:
+    /// Iterator to the element at idx, end() for idx == size()
+    CDT_CONSTEXPR iterator nth(size_type idx) CDT_CHECK_NOEXCEPT {
+        detail::check<std::out_of_range>(idx <= size(), "Demanded idx is out of range.");
+        return ListIterator(&data, seek(idx));
+    }
+    /// Index of the element position points to, size() for end()
+    CDT_CONSTEXPR size_type index_of(const_iterator position) {
+        size_type idx = index_at(position.m_offset);
+        remember(idx, position.m_offset);
+        return idx;
+    }
+    CDT_CONSTEXPR size_type index_of(const_iterator position) const {
+        return index_at(position.m_offset);
+    }
+    /// Iterator n elements after (or before, if n is negative) position
+    CDT_CONSTEXPR iterator advance(const_iterator position, difference_type n) {
+        size_type idx;
+        if (known_index(position.m_offset, idx)) {
+            return nth(idx + n);
         }
-        iterator it = begin();
-        for (size_t i = 0; i < idx; i++) {
-            it++;
+        iterator it = position;
+        for (; n > 0; --n) {
+            ++it;
+        }
+        for (; n < 0; ++n) {
+            --it;
         }
-        return *it;
+        return it;
+    }
+    /// Number of elements from first to last
+    CDT_CONSTEXPR difference_type distance(const_iterator first, const_iterator last) const {
+        return static_cast<difference_type>(index_of(last)) - static_cast<difference_type>(index_of(first));
     }
 
     // modifiers:
-    void push_front(const value_type& x) {
+    CDT_CONSTEXPR void push_front(const value_type& x) {
         this->insert(begin(), x);
     }
-    void push_front(value_type&& x) {
+    CDT_CONSTEXPR void push_front(value_type&& x) {
         this->insert(begin(), std::move(x));
     }
     template <typename... _Args>
-    void emplace_front(_Args&&... __args) {
-        this->insert(begin(), std::forward<_Args>(__args)...);
+    CDT_CONSTEXPR void emplace_front(_Args&&... __args) {
+        this->emplace(begin(), std::forward<_Args>(__args)...);
     }
 
-    void pop_front() {
+    CDT_CONSTEXPR void pop_front() {
         this->erase(begin());
     }
-    void push_back(const value_type& x) {
+    CDT_CONSTEXPR void push_back(const value_type& x) {
         this->insert(end(), x);
     }
-    void push_back(value_type&& x) {
+    CDT_CONSTEXPR void push_back(value_type&& x) {
         this->insert(end(), std::move(x));
     }
     template <typename... _Args>
-    void emplace_back(_Args&&... __args) {
-        this->insert(end(), std::forward<_Args>(__args)...);
+    CDT_CONSTEXPR void emplace_back(_Args&&... __args) {
+        this->emplace(end(), std::forward<_Args>(__args)...);
     }
-    void pop_back() {
+    CDT_CONSTEXPR void pop_back() {
         this->erase(--end()); // end points one past the last element, so decrement it first.
     }                         // TODO
 
-    // template <class... Args>
-    // iterator emplace(const_iterator position, Args&&... args);
-    // iterator insert(const_iterator position, const value_type& x);
-    iterator insert(const_iterator position, value_type&& x) {
-        // Allocate memory
-        position_type i_new = allocator.allocate();
-        data[i_new].data = x;
+    /// Construct a new element in place before position
+    template <typename... _Args>
+    CDT_CONSTEXPR iterator emplace(const_iterator position, _Args&&... __args) {
+        position_type i_new = create_node(std::forward<_Args>(__args)...);
+        link_chain(position.m_offset, i_new, i_new);
+        return ListIterator(&data, i_new);
+    }
+    CDT_CONSTEXPR iterator insert(const_iterator position, const value_type& x) {
+        return this->emplace(position, x);
+    }
+    CDT_CONSTEXPR iterator insert(const_iterator position, value_type&& x) {
+        return this->emplace(position, std::move(x));
+    }
+
+    /// Insert n copies of x before position.
+    /// Either all or none of the elements are inserted.
+    CDT_CONSTEXPR iterator insert(const_iterator position, size_type n, const value_type& x) {
+        assert_capacity(n);
+        Chain chain;
+        try {
+            for (; n > 0; --n) {
+                chain.append(data, create_node(x));
+            }
+        } catch (...) {
+            destroy_chain(chain);
+            throw;
+        }
+        return link_chain(position.m_offset, chain);
+    }
 
-        // Get index of position iterator
-        size_t i_it = reinterpret_cast<position_type>(position.m_offset);
+    /// Insert the elements of [first, last) before position.
+    /// Either all or none of the elements are inserted. For forward iterators, the capacity is checked up front.
+    template <class _InputIterator,
+              typename = typename std::enable_if<!std::is_integral<_InputIterator>::value>::type>
+    CDT_CONSTEXPR iterator insert(const_iterator position, _InputIterator first, _InputIterator last) {
+        assert_capacity(first, last, typename std::iterator_traits<_InputIterator>::iterator_category());
+        Chain chain;
+        try {
+            for (; first != last; ++first) {
+                chain.append(data, create_node(*first));
+            }
+        } catch (...) {
+            destroy_chain(chain);
+            throw;
+        }
+        return link_chain(position.m_offset, chain);
+    }
 
-        // Insert element before current object
-        data[position.get_node()->prev].next = i_new;
-        data[i_new].prev = position.get_node()->prev;
-        data[i_new].next = i_it;
-        position.get_node()->prev = i_new;
+    CDT_CONSTEXPR iterator insert(const_iterator position, std::initializer_list<value_type> il) {
+        return this->insert(position, il.begin(), il.end());
+    }
 
-        return ListIterator(&data[0], i_new);
-    };
+    /// Replace the contents with n copies of x
+    CDT_CONSTEXPR void assign(size_type n, const value_type& x) {
+        this->clear();
+        this->insert(end(), n, x);
+    }
+    /// Replace the contents with the elements of [first, last)
+    template <class _InputIterator,
+              typename = typename std::enable_if<!std::is_integral<_InputIterator>::value>::type>
+    CDT_CONSTEXPR void assign(_InputIterator first, _InputIterator last) {
+        this->clear();
+        this->insert(end(), first, last);
+    }
+    CDT_CONSTEXPR void assign(std::initializer_list<value_type> il) {
+        this->assign(il.begin(), il.end());
+    }
+
+    CDT_CONSTEXPR iterator erase(const_iterator position) {
+        detail::check<std::out_of_range>(position != end(), "Iterator points past valid data. Can not erase.");
+        invalidate_cursor();
+        contiguous = false;
 
-    // iterator insert(const_iterator position, size_type n, const value_type& x);
-    // template <class InputIterator>
-    // iterator insert(const_iterator position, InputIterator first, InputIterator last);
-    // iterator insert(const_iterator position, initializer_list<T>);
+        // Get index of element
+        position_type i = position.m_offset;
+        position_type i_next = data.next(i);
+
+        // Adjust neighbors
+        data.next(data.prev(i)) = i_next;
+        data.prev(i_next) = data.prev(i);
 
-    iterator erase(const_iterator position) {
-        if (position == end()) {
-            throw std::out_of_range("Iterator points past valid data. Can not erase.");
+        // Destroy payload and free memory
+        data.payload(i).destroy();
+        allocator.deallocate(data, i);
+        this->record_erase();
+
+        return ListIterator(&data, i_next);
+    }
+
+    /// Erase all elements in [first, last).
+    /// The range is unlinked at once and handed back to the allocator as one chain.
+    CDT_CONSTEXPR iterator erase(const_iterator first, const_iterator last) {
+        if (first == last) {
+            return last;
         }
+        invalidate_cursor();
+        contiguous = false;
+        position_type i_first = first.m_offset;
+        position_type i_last = data.prev(last.m_offset);
+
         // Adjust neighbors
-        data[position.get_node()->prev].next = position.get_node()->next;
-        data[position.get_node()->next].prev = position.get_node()->prev;
+        data.next(data.prev(i_first)) = last.m_offset;
+        data.prev(last.m_offset) = data.prev(i_first);
 
-        // Get index of element
-        size_t i = reinterpret_cast<position_type>(position.m_offset);
+        // Destroy payloads and free memory
+        size_type n = 1;
+        for (position_type i = i_first; i != i_last; i = data.next(i), ++n) {
+            data.payload(i).destroy();
+        }
+        data.payload(i_last).destroy();
+        allocator.deallocate_chain(data, i_first, i_last, n);
+        this->record_erase(n);
 
-        // Free memory and reinitialize
-        allocator.deallocate(i);
-        data[i] = Node();
+        return last;
     }
 
-    // iterator erase(const_iterator first, const_iterator last);
-    // void swap(list<T, Allocator>&);
-    void clear() {
-        for (size_t i = 0; i < _N + 1; i++) {
-            data[i] = Node();
+    /// Move the elements of other before position.
+    CDT_CONSTEXPR void splice(const_iterator position, list_type& other) {
+        this->splice(position, other, other.begin(), other.end());
+    }
+    /// Move the element it of other before position.
+    CDT_CONSTEXPR void splice(const_iterator position, list_type& other, const_iterator it) {
+        iterator last = it;
+        this->splice(position, other, it, ++last);
+    }
+    /// Move the elements [first, last) of other before position.
+    /// Within the same list this only relinks the range in constant time, without touching the payloads.
+    /// Across lists the payloads have to be moved into this list's storage, which takes linear time.
+    CDT_CONSTEXPR void splice(const_iterator position, list_type& other, const_iterator first, const_iterator last) {
+        if (&other != this) {
+            this->insert(position, std::make_move_iterator(first), std::make_move_iterator(last));
+            other.erase(first, last);
+            return;
+        }
+        if (first == last || position == first || position == last) {
+            return;
         }
+        invalidate_cursor();
+        contiguous = false;
+        position_type i_first = first.m_offset;
+        position_type i_last = data.prev(last.m_offset);
+
+        // Unlink range
+        data.next(data.prev(i_first)) = last.m_offset;
+        data.prev(last.m_offset) = data.prev(i_first);
+
+        // Link range before position
+        link_chain(position.m_offset, i_first, i_last);
+    }
+
+    /// Exchange the elements with other in O(size() + other.size()), only the slots in use are touched.
+    /// Dense lists of trivially copyable elements exchange their slots as raw bytes, see copy_from().
+    /// Otherwise the payloads of the common length are swapped in place and the rest of the longer list is moved over.
+    /// Invalidates all iterators.
+    CDT_CONSTEXPR void swap(list_type& other) {
+        if (&other == this) {
+            return;
+        }
+        if (std::is_trivially_copyable<value_type>::value && !detail::is_constant_evaluated() && is_dense() &&
+            other.is_dense()) {
+            const size_type n = std::max(allocator.watermark(), other.allocator.watermark());
+            data.swap_prefix(other.data, n);
+            std::swap(allocator, other.allocator);
+            std::swap(contiguous, other.contiguous);
+            invalidate_cursor();
+            other.invalidate_cursor();
+            return;
+        }
+        list_type& shorter = size() < other.size() ? *this : other;
+        list_type& longer = size() < other.size() ? other : *this;
+        position_type i = shorter.data.next(_N);
+        position_type j = longer.data.next(_N);
+        for (; i != _N; i = shorter.data.next(i), j = longer.data.next(j)) {
+            using std::swap;
+            swap(shorter.data.payload(i).value, longer.data.payload(j).value);
+        }
+        if (j != _N) {
+            const iterator rest(&longer.data, j);
+            shorter.insert(shorter.end(), std::make_move_iterator(rest), std::make_move_iterator(longer.end()));
+            longer.erase(rest, longer.end());
+        }
+    }
+    CDT_CONSTEXPR void clear() {
+        if (!std::is_trivially_destructible<value_type>::value) {
+            for (position_type i = data.next(_N); i != _N; i = data.next(i)) {
+                data.payload(i).destroy();
+            }
+        }
+        this->record_erase(size());
+        reset_sentinel();
         allocator.clear();
     };
 
-    void remove(const value_type& value);
-    // template <class Predicate>
-    // void remove_if(Predicate pred);
+    // operations:
+    /// Sort the elements stably in ascending order.
+    /// Only the links are rewritten, payloads are neither moved nor copied.
+    /// If comp throws, all elements stay in the list in an unspecified order.
+    CDT_CONSTEXPR void sort() {
+        this->sort(std::less<value_type>());
+    }
+    template <class _Compare>
+    CDT_CONSTEXPR void sort(_Compare comp) {
+        if (size() < 2) {
+            return;
+        }
+        invalidate_cursor();
+        contiguous = false;
+
+        // Bottom up merge sort over the next links, runs of width 1, 2, 4, ... are merged pairwise.
+        // The sentinel serves as anchor of the merged list.
+        position_type p = _N;
+        position_type q = _N;
+        position_type tail = _N;
+        size_type p_size = 0;
+        try {
+            for (size_type width = 1;; width *= 2) {
+                p = data.next(_N);
+                tail = _N;
+                size_type merges = 0;
+                while (p != _N) {
+                    ++merges;
+                    // Find the start of the second run
+                    q = p;
+                    p_size = 0;
+                    while (p_size < width && q != _N) {
+                        ++p_size;
+                        q = data.next(q);
+                    }
+                    size_type q_size = width;
+
+                    // Merge both runs, prefer the first one on equality to keep the sort stable
+                    while (p_size > 0 || (q_size > 0 && q != _N)) {
+                        position_type e;
+                        if (p_size == 0) {
+                            e = q;
+                            q = data.next(q);
+                            --q_size;
+                        } else if (q_size == 0 || q == _N || !comp(data.payload(q).value, data.payload(p).value)) {
+                            e = p;
+                            p = data.next(p);
+                            --p_size;
+                        } else {
+                            e = q;
+                            q = data.next(q);
+                            --q_size;
+                        }
+                        data.next(tail) = e;
+                        tail = e;
+                    }
+                    p = q;
+                }
+                data.next(tail) = _N;
+                if (merges <= 1) {
+                    break;
+                }
+            }
+        } catch (...) {
+            // The unmerged rest of the first run still links to the old start of the second run, and the rest of the
+            // second run to all later runs. Chain both behind the merged nodes, so that every element stays listed.
+            if (p_size > 0) {
+                data.next(tail) = p;
+                for (; p_size > 1; --p_size) {
+                    p = data.next(p);
+                }
+                data.next(p) = q;
+            } else {
+                data.next(tail) = q;
+            }
+            relink_prev();
+            throw;
+        }
+        relink_prev();
+    }
+
+    /// Merge the sorted list other into this sorted list, other is empty afterwards.
+    /// Payloads of other have to be moved into this list's storage, so only the capacity is checked up front.
+    /// If comp or a move throws, the elements merged so far stay in this list and are erased from other.
+    CDT_CONSTEXPR void merge(list_type& other) {
+        this->merge(other, std::less<value_type>());
+    }
+    template <class _Compare>
+    CDT_CONSTEXPR void merge(list_type& other, _Compare comp) {
+        if (&other == this) {
+            return;
+        }
+        assert_capacity(other.size());
+        iterator it = begin();
+        iterator ot = other.begin();
+        try {
+            for (; ot != other.end(); ++ot) {
+                while (it != end() && !comp(*ot, *it)) {
+                    ++it;
+                }
+                this->emplace(it, std::move(*ot));
+            }
+        } catch (...) {
+            other.erase(other.begin(), ot);
+            throw;
+        }
+        other.clear();
+    }
+
+    /// Erase all but the first element of each group of consecutive equal elements.
+    /// Returns the number of erased elements. If pred throws, the duplicates found so far are erased.
+    CDT_CONSTEXPR size_type unique() {
+        return this->unique(std::equal_to<value_type>());
+    }
+    template <class _BinaryPredicate>
+    CDT_CONSTEXPR size_type unique(_BinaryPredicate pred) {
+        Chain removed;
+        position_type i = data.next(_N);
+        if (i == _N) {
+            return 0;
+        }
+        try {
+            for (position_type j = data.next(i); j != _N; j = data.next(i)) {
+                if (pred(data.payload(i).value, data.payload(j).value)) {
+                    data.next(i) = data.next(j);
+                    removed.append(data, j);
+                } else {
+                    data.prev(j) = i;
+                    i = j;
+                }
+            }
+        } catch (...) {
+            // The node after i may still point back to an erased node, only the nodes already found are erased
+            data.prev(data.next(i)) = i;
+            invalidate_cursor();
+            destroy_chain(removed);
+            throw;
+        }
+        data.prev(_N) = i;
+        if (removed.size > 0) {
+            invalidate_cursor();
+            destroy_chain(removed);
+        }
+        return removed.size;
+    }
+
+    /// Reverse the order of the elements by swapping the links of each node.
+    CDT_CONSTEXPR void reverse() {
+        invalidate_cursor();
+        contiguous = contiguous && size() < 2;
+        position_type i = _N;
+        do {
+            std::swap(data.next(i), data.prev(i));
+            i = data.prev(i);
+        } while (i != _N);
+    }
+
+    /// Relocate the payloads, so that the list order matches the slot order 0..size()-1.
+    /// Iterating afterwards streams linearly through memory. Invalidates all iterators.
+    CDT_CONSTEXPR void compact() {
+        if (contiguous) {
+            return;
+        }
+        invalidate_cursor();
+        position_type i = data.next(_N);
+        for (position_type k = 0; i != _N; ++k) {
+            position_type i_next = data.next(i);
+            if (i != k) {
+                // Slots below k already hold the first k elements, so k is either free or holds a later element.
+                if (!data.is_used(k)) {
+                    relocate_node(i, k);
+                    data.mark_used(k);
+                    data.mark_free(i);
+                } else {
+                    swap_nodes(i, k);
+                    if (i_next == k) {
+                        i_next = i;
+                    }
+                }
+            }
+            i = i_next;
+        }
+        allocator.reset_packed(data, size());
+        contiguous = true;
+    }
+
+    /// Whether list order currently matches the slot order 0..size()-1, see compact().
+    /// Appending to a contiguous list keeps it contiguous, every other modification may break it.
+    CDT_CONSTEXPR bool is_contiguous() const {
+        return contiguous;
+    }
+
+    /// Pointer to the payloads as plain array of size() elements, nullptr if the list is not contiguous.
+    /// Only available with SplitLayout, where payloads are stored without links in between.
+    CDT_CONSTEXPR pointer contiguous_data() {
+        static_assert(std::is_same<_Layout, SplitLayout>::value, "Payloads are only stored densely in SplitLayout.");
+        return contiguous ? &data.payload(0).value : nullptr;
+    }
+    CDT_CONSTEXPR const_pointer contiguous_data() const {
+        static_assert(std::is_same<_Layout, SplitLayout>::value, "Payloads are only stored densely in SplitLayout.");
+        return contiguous ? &data.payload(0).value : nullptr;
+    }
+
+    /// Number of slots, which may hold elements. The slot ranges of for_each_unordered() lie within 0..slot_count().
+    CDT_CONSTEXPR size_type slot_count() const noexcept {
+        return allocator.watermark();
+    }
+    /// Apply fn to every element in slot order, which generally differs from list order.
+    /// The occupancy bitmap is scanned a word at a time, so the payloads are visited by increasing address
+    /// instead of following links. fn must neither insert nor erase elements.
+    template <class _Function>
+    CDT_CONSTEXPR void for_each_unordered(_Function fn) {
+        visit_slots(data, 0, slot_count(), fn);
+    }
+    template <class _Function>
+    CDT_CONSTEXPR void for_each_unordered(_Function fn) const {
+        visit_slots(data, 0, slot_count(), fn);
+    }
+    /// Apply fn to the elements in the slots first..last-1, see for_each_unordered().
+    /// Disjoint slot ranges may be processed concurrently, as long as fn only accesses the element it is passed.
+    /// This allows to split a bulk update into chunks for a thread pool, see for_each_parallel() in parallel.hpp.
+    template <class _Function>
+    CDT_CONSTEXPR void for_each_unordered(size_type first, size_type last, _Function fn) {
+        visit_slots(data, first, last, fn);
+    }
+    template <class _Function>
+    CDT_CONSTEXPR void for_each_unordered(size_type first, size_type last, _Function fn) const {
+        visit_slots(data, first, last, fn);
+    }
+
+    /// Erase all elements equal to value in a single traversal, the freed slots are returned to the allocator at once.
+    /// Returns the number of erased elements.
+    CDT_CONSTEXPR size_type remove(const value_type& value) {
+        return this->remove_if([&value](const value_type& x) { return x == value; });
+    }
+    template <class _Predicate>
+    CDT_CONSTEXPR size_type remove_if(_Predicate pred) {
+        // Every node is appended to either the kept or the removed chain, selected without a branch.
+        // Appending to an empty chain writes to the sentinel, so its links are fixed up at the end.
+        position_type kept_first = _N;
+        position_type kept_last = _N;
+        Chain removed;
+        position_type j = data.next(_N);
+        try {
+            while (j != _N) {
+                const position_type j_next = data.next(j);
+                const bool drop = pred(data.payload(j).value);
+                const position_type tail = drop ? removed.last : kept_last;
+                data.next(tail) = j;
+                data.prev(j) = tail;
+                kept_first = kept_first == _N && !drop ? j : kept_first;
+                removed.first = removed.first == _N && drop ? j : removed.first;
+                (drop ? removed.last : kept_last) = j;
+                removed.size += drop;
+                j = j_next;
+            }
+        } catch (...) {
+            // Keep the unvisited nodes behind the kept ones, only the nodes already found are erased
+            data.next(kept_last) = j;
+            data.prev(j) = kept_last;
+            data.next(_N) = kept_first != _N ? kept_first : j;
+            invalidate_cursor();
+            destroy_chain(removed);
+            throw;
+        }
+        data.next(kept_last) = _N;
+        data.next(_N) = kept_first;
+        data.prev(_N) = kept_last;
+        if (removed.size > 0) {
+            invalidate_cursor();
+            destroy_chain(removed);
+        }
+        return removed.size;
+    }
+
+    // snapshots, only available for trivially copyable value_type:
+    /// The snapshot holds the whole node array, so taking and restoring it copies a single block without a walk.
+    /// Unused slots are copied as they are, so they may carry bytes of erased elements.
+    /// Bytes needed by snapshot(), independent of the size
+    static constexpr size_type snapshot_size() noexcept {
+        return image_offset() + sizeof(storage_type);
+    }
+    /// Copy a header and the node array into buffer, returns the number of written bytes.
+    /// Throws std::length_error if bytes is less than snapshot_size().
+    size_type snapshot(void* buffer, size_type bytes) const {
+        static_assert(std::is_trivially_copyable<value_type>::value, "Snapshots need trivially copyable elements.");
+        SnapshotHeader header = snapshot_header();
+        allocator.save(header);
+        header.flags = contiguous;
+        return detail::write_snapshot(buffer, bytes, header, &data, image_offset(), sizeof(storage_type));
+    }
+    /// Replace the elements by those of a snapshot.
+    /// Throws std::invalid_argument if the snapshot was taken from a different type or is truncated.
+    void restore(const void* buffer, size_type bytes) {
+        static_assert(std::is_trivially_copyable<value_type>::value, "Snapshots need trivially copyable elements.");
+        const SnapshotHeader header = detail::read_snapshot_header(buffer, bytes, snapshot_header());
+        const void* image = detail::snapshot_image(buffer, bytes, image_offset(), sizeof(storage_type), 1);
+        this->clear();
+        allocator.load(header);
+        std::memcpy(static_cast<void*>(&data), image, sizeof(storage_type));
+        contiguous = header.flags & 1;
+        this->record_insert(size(), size());
+    }
+
+    /// \brief Read-only view of a snapshot, which follows the links in place without copying the nodes.
+    /// The buffer has to outlive the view and has to be aligned for value_type.
+    class View {
+    public:
+        class const_iterator {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef _Tp value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const _Tp* pointer;
+            typedef const _Tp& reference;
+
+            const_iterator(const storage_type* start, position_type offset) : m_start(start), m_offset(offset) {
+            }
+            reference operator*() const CDT_CHECK_NOEXCEPT {
+                detail::check<std::out_of_range>(m_offset < _N, "Iterator is out of range.");
+                return m_start->payload(m_offset).value;
+            }
+            pointer operator->() const CDT_CHECK_NOEXCEPT {
+                return &**this;
+            }
+            const_iterator& operator++() noexcept {
+                m_offset = m_start->next(m_offset);
+                return *this;
+            }
+            const_iterator operator++(int) noexcept {
+                const_iterator __tmp = *this;
+                ++*this;
+                return __tmp;
+            }
+            bool operator==(const const_iterator& x) const noexcept {
+                return m_start == x.m_start && m_offset == x.m_offset;
+            }
+            bool operator!=(const const_iterator& x) const noexcept {
+                return !(*this == x);
+            }
+
+        private:
+            const storage_type* m_start;
+            position_type m_offset;
+        };
+
+        /// Throws std::invalid_argument if the snapshot was taken from a different type, is truncated or misaligned
+        View(const void* buffer, size_type bytes) {
+            static_assert(std::is_trivially_copyable<value_type>::value, "Snapshots need trivially copyable elements.");
+            n = detail::read_snapshot_header(buffer, bytes, snapshot_header()).size;
+            nodes = static_cast<const storage_type*>(
+                    detail::snapshot_image(buffer, bytes, image_offset(), sizeof(storage_type), alignof(storage_type)));
+        }
+
+        size_type size() const noexcept {
+            return n;
+        }
+        bool empty() const noexcept {
+            return n == 0;
+        }
+        const_iterator begin() const noexcept {
+            return const_iterator(nodes, nodes->next(_N));
+        }
+        const_iterator end() const noexcept {
+            return const_iterator(nodes, _N);
+        }
+
+    private:
+        const storage_type* nodes;
+        size_type n;
+    };
 
 private:
-    node_type data[_N + 1]; // We store one element more in order to track begin and end
+    static SnapshotHeader snapshot_header() {
+        return detail::snapshot_header<_Tp, _N, position_type>(std::is_same<_Layout, SplitLayout>::value
+                                                                       ? SnapshotHeader::ARRAY_LIST_SPLIT
+                                                                       : SnapshotHeader::ARRAY_LIST_INTERLEAVED);
+    }
+    static constexpr size_type image_offset() {
+        return detail::snapshot_offset(alignof(storage_type));
+    }
+
+    /// Call fn on the payloads of the used slots in first..last-1, clipped to the slots below the watermark
+    template <class _Storage, class _Function>
+    CDT_CONSTEXPR void visit_slots(_Storage& nodes, size_type first, size_type last, _Function& fn) const {
+        enum : size_type { WORD_BITS = storage_type::WORD_BITS };
+        last = std::min(last, slot_count());
+        if (first >= last) {
+            return;
+        }
+        const size_type w_first = first / WORD_BITS;
+        const size_type w_last = (last - 1) / WORD_BITS;
+        for (size_type w = w_first; w <= w_last; ++w) {
+            uint64_t bits = nodes.used_bits(w);
+            if (w == w_first) {
+                bits &= ~uint64_t(0) << (first % WORD_BITS);
+            }
+            if (w == w_last && last % WORD_BITS != 0) {
+                bits &= (uint64_t(1) << (last % WORD_BITS)) - 1;
+            }
+            for (; bits != 0; bits &= bits - 1) {
+                fn(nodes.payload(static_cast<position_type>(w * WORD_BITS + detail::count_trailing_zeros(bits))).value);
+            }
+        }
+    }
+
+    /// Run of nodes, which are chained by their links but not yet part of the list
+    struct Chain {
+        CDT_CONSTEXPR Chain() : first(_N), last(_N), size(0){};
+        CDT_CONSTEXPR void append(storage_type& nodes, position_type i) {
+            if (first == _N) {
+                first = i;
+            } else {
+                nodes.next(last) = i;
+                nodes.prev(i) = last;
+            }
+            last = i;
+            ++size;
+        }
+        position_type first;
+        position_type last;
+        size_type size;
+    };
+
+    /// Allocate a node and construct its payload in place
+    template <typename... _Args>
+    CDT_CONSTEXPR position_type create_node(_Args&&... __args) {
+        this->record_overflow(size(), 1, max_size());
+        const bool recycled = allocator.recycling();
+        position_type i_new = allocator.allocate(data);
+        try {
+            data.payload(i_new).construct(std::forward<_Args>(__args)...);
+        } catch (...) {
+            allocator.deallocate(data, i_new);
+            throw;
+        }
+        this->record_insert(size());
+        if (recycled) {
+            this->record_recycled();
+        }
+        return i_new;
+    }
+
+    /// Trivially copyable elements are copied as raw slots, including the unused ones below the allocator's watermark,
+    /// which keeps the slot layout of other. A sparse list, where most of these slots are unused, is packed instead.
+    CDT_CONSTEXPR void copy_from(const list_type& other, std::true_type) {
+        if (detail::is_constant_evaluated() || !other.is_dense()) {
+            fill_packed(other);
+            return;
+        }
+        data.copy_prefix(other.data, other.allocator.watermark());
+        allocator = other.allocator;
+        contiguous = other.contiguous;
+        this->record_insert(size(), size());
+    }
+    CDT_CONSTEXPR void copy_from(const list_type& other, std::false_type) {
+        fill_packed(other);
+    }
+    CDT_CONSTEXPR void move_from(list_type& other, std::true_type) {
+        copy_from(other, std::true_type());
+        other.clear();
+    }
+    CDT_CONSTEXPR void move_from(list_type& other, std::false_type) {
+        fill_packed(other);
+        other.clear();
+    }
+
+    /// Whether at least half of the slots below the allocator's watermark are in use
+    CDT_CONSTEXPR bool is_dense() const {
+        return allocator.watermark() <= 2 * size();
+    }
+
+    /// Fill this empty list with the elements of other in list order, using the slots 0..n-1.
+    /// Elements are copied from a const list and moved from a mutable one.
+    template <typename _List>
+    CDT_CONSTEXPR void fill_packed(_List& other) {
+        typedef typename std::conditional<std::is_const<_List>::value, const value_type&, value_type&&>::type source;
+        position_type k = 0;
+        try {
+            for (position_type i = other.data.next(_N); i != _N; i = other.data.next(i), ++k) {
+                data.payload(k).construct(static_cast<source>(other.data.payload(i).value));
+                data.next(k) = k + 1;
+                data.prev(k) = k - 1;
+            }
+        } catch (...) {
+            for (; k > 0; --k) {
+                data.payload(k - 1).destroy();
+            }
+            throw;
+        }
+        if (k > 0) {
+            data.prev(0) = _N;
+            data.next(k - 1) = _N;
+            data.next(_N) = 0;
+            data.prev(_N) = k - 1;
+        }
+        allocator.reset_packed(data, k);
+        contiguous = true;
+        this->record_insert(k, k);
+    }
+
+    /// Destroy and free the nodes of a chain, which has not been linked into the list
+    CDT_CONSTEXPR void destroy_chain(const Chain& chain) {
+        if (chain.size == 0) {
+            return;
+        }
+        if (!std::is_trivially_destructible<value_type>::value) {
+            for (position_type i = chain.first; i != chain.last; i = data.next(i)) {
+                data.payload(i).destroy();
+            }
+            data.payload(chain.last).destroy();
+        }
+        allocator.deallocate_chain(data, chain.first, chain.last, chain.size);
+        this->record_erase(chain.size);
+        contiguous = false;
+    }
+
+    /// Link the nodes first..last before the node at position
+    CDT_CONSTEXPR iterator link_chain(position_type position, const Chain& chain) {
+        if (chain.first == _N) {
+            return ListIterator(&data, position);
+        }
+        return link_chain(position, chain.first, chain.last);
+    }
+    CDT_CONSTEXPR iterator link_chain(position_type position, position_type first, position_type last) {
+        invalidate_cursor();
+        // Appending keeps a contiguous list contiguous, since the allocator hands out the slots in order then
+        contiguous = contiguous && position == _N;
+        position_type before = data.prev(position);
+        data.next(before) = first;
+        data.prev(first) = before;
+        data.next(last) = position;
+        data.prev(position) = last;
+        return ListIterator(&data, first);
+    }
+
+    /// Check whether n more elements fit into the list
+    CDT_CONSTEXPR void assert_capacity(size_type n) const CDT_CHECK_NOEXCEPT {
+        this->record_overflow(size(), n, max_size());
+        detail::check<std::length_error>(n <= max_size() - size(), "No space left in DLList.");
+    }
+    template <class _InputIterator>
+    CDT_CONSTEXPR void assert_capacity(_InputIterator, _InputIterator, std::input_iterator_tag) const {
+        // The number of elements is not known up front, the allocator checks on each insertion.
+    }
+    template <class _ForwardIterator>
+    CDT_CONSTEXPR void assert_capacity(_ForwardIterator first, _ForwardIterator last, std::forward_iterator_tag) const {
+        assert_capacity(static_cast<size_type>(std::distance(first, last)));
+    }
+
+    /// Slot of the element at idx, walking from the nearest known position
+    CDT_CONSTEXPR position_type slot_at(size_type idx) const {
+        const size_type n = size();
+        position_type slot;
+        size_type from;
+        if (idx < n - idx) {
+            slot = data.next(_N);
+            from = 0;
+        } else {
+            slot = _N;
+            from = n;
+        }
+        if (cached_slot() != _N && absdiff(cursor_index, idx) < absdiff(from, idx)) {
+            slot = cursor_slot;
+            from = cursor_index;
+        }
+        this->record_scan(absdiff(from, idx));
+        for (; from < idx; ++from) {
+            slot = data.next(slot);
+        }
+        for (; from > idx; --from) {
+            slot = data.prev(slot);
+        }
+        return slot;
+    }
+    /// Slot of the element at idx like slot_at(), which is cached for subsequent positional access
+    CDT_CONSTEXPR position_type seek(size_type idx) {
+        const position_type slot = slot_at(idx);
+        remember(idx, slot);
+        return slot;
+    }
+
+    /// Index of the element in slot, walking in both directions until a known position is hit
+    CDT_CONSTEXPR size_type index_at(position_type slot) const {
+        const position_type cursor = cached_slot();
+        position_type forward = slot;
+        position_type backward = slot;
+        for (size_type steps = 0;; ++steps) {
+            if (forward == _N) {
+                this->record_scan(steps);
+                return size() - steps;
+            }
+            if (forward == cursor) {
+                this->record_scan(steps);
+                return cursor_index - steps;
+            }
+            if (backward == data.next(_N)) {
+                this->record_scan(steps);
+                return steps;
+            }
+            if (backward == cursor) {
+                this->record_scan(steps);
+                return cursor_index + steps;
+            }
+            forward = data.next(forward);
+            backward = data.prev(backward);
+        }
+    }
+
+    /// Look up the index of slot, if it is available without walking
+    CDT_CONSTEXPR bool known_index(position_type slot, size_type& idx) const {
+        if (slot == _N) {
+            idx = size();
+        } else if (slot == data.next(_N)) {
+            idx = 0;
+        } else if (slot == cached_slot()) {
+            idx = cursor_index;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    /// Slot of the cached position, _N if there is none.
+    /// The cache is not used while constant evaluated, so that lookups in a constexpr list do not depend on it.
+    CDT_CONSTEXPR position_type cached_slot() const {
+        return detail::is_constant_evaluated() ? static_cast<position_type>(_N) : cursor_slot;
+    }
+    /// Cache the position of an element for subsequent positional access
+    CDT_CONSTEXPR void remember(size_type idx, position_type slot) {
+        if (slot != _N && !detail::is_constant_evaluated()) {
+            cursor_index = idx;
+            cursor_slot = slot;
+        }
+    }
+    /// Forget the cached position, needed whenever the list is modified
+    CDT_CONSTEXPR void invalidate_cursor() {
+        cursor_slot = _N;
+    }
+
+    static CDT_CONSTEXPR size_type absdiff(size_type a, size_type b) {
+        return a < b ? b - a : a - b;
+    }
+
+    /// Move the node in slot from into the unused slot to
+    CDT_CONSTEXPR void relocate_node(position_type from, position_type to) {
+        data.payload(to).construct(std::move(data.payload(from).value));
+        data.payload(from).destroy();
+        data.prev(to) = data.prev(from);
+        data.next(to) = data.next(from);
+        data.next(data.prev(to)) = to;
+        data.prev(data.next(to)) = to;
+    }
+
+    /// Exchange the slots of two linked nodes, which may be neighbors
+    CDT_CONSTEXPR void swap_nodes(position_type a, position_type b) {
+        value_type tmp(std::move(data.payload(a).value));
+        data.payload(a).destroy();
+        data.payload(a).construct(std::move(data.payload(b).value));
+        data.payload(b).destroy();
+        data.payload(b).construct(std::move(tmp));
+
+        // Links pointing to a have to point to b afterwards and vice versa
+        auto swapped = [a, b](position_type i) { return i == a ? b : (i == b ? a : i); };
+        position_type prev_a = data.prev(a);
+        position_type next_a = data.next(a);
+        data.prev(a) = swapped(data.prev(b));
+        data.next(a) = swapped(data.next(b));
+        data.prev(b) = swapped(prev_a);
+        data.next(b) = swapped(next_a);
+        data.next(data.prev(a)) = a;
+        data.prev(data.next(a)) = a;
+        data.next(data.prev(b)) = b;
+        data.prev(data.next(b)) = b;
+    }
+
+    /// Restore the prev links from the next links
+    CDT_CONSTEXPR void relink_prev() {
+        position_type prev = _N;
+        for (position_type i = data.next(_N); i != _N; i = data.next(i)) {
+            data.prev(i) = prev;
+            prev = i;
+        }
+        data.prev(_N) = prev;
+    }
+
+    /// Let the sentinel node point to itself, which marks the list as empty
+    CDT_CONSTEXPR void reset_sentinel() {
+        data.next(_N) = _N;
+        data.prev(_N) = _N;
+        invalidate_cursor();
+        contiguous = true;
+    }
+
+    storage_type data;
     Allocator allocator;
+    position_type cursor_index; ///< Index of the last element accessed through a non-const list
+    position_type cursor_slot;  ///< Slot of that element, _N if unknown
+    bool contiguous;            ///< Whether list order matches slot order, see compact()
 };
+
+/// Exchange the elements of two lists, see ArrayList::swap()
+template <typename _Tp, size_t _N, typename _Layout>
+CDT_CONSTEXPR void swap(ArrayList<_Tp, _N, _Layout>& a, ArrayList<_Tp, _N, _Layout>& b) {
+    a.swap(b);
+}
 } // Namespace cpb
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+/// \brief Bounds and capacity checks of all containers.
+/// The policy is selected by defining CDT_CHECK_POLICY before including any container:
+/// - CDT_CHECKED (default): violations throw std::out_of_range or std::length_error
+/// - CDT_DEBUG_ASSERT: violations fail an assert(), so they are not checked at all with NDEBUG
+/// - CDT_UNCHECKED: violations are undefined behavior
+/// Without the throwing checks, element access is noexcept and reduces to plain loads.
+/// at() follows the std convention and always checks, independent of the policy.
+/// All translation units of a program have to agree on the policy, mixing them violates the one definition rule.
+#define CDT_CHECKED 0
+#define CDT_DEBUG_ASSERT 1
+#define CDT_UNCHECKED 2
+
+#ifndef CDT_CHECK_POLICY
+#define CDT_CHECK_POLICY CDT_CHECKED
+#endif
+
+#if CDT_CHECK_POLICY == CDT_CHECKED
+#define CDT_CHECK_NOEXCEPT
+#elif CDT_CHECK_POLICY == CDT_DEBUG_ASSERT || CDT_CHECK_POLICY == CDT_UNCHECKED
+#define CDT_CHECK_NOEXCEPT noexcept
+#else
+#error "CDT_CHECK_POLICY has to be one of CDT_CHECKED, CDT_DEBUG_ASSERT or CDT_UNCHECKED."
+#endif
+
+#include <array_list/detail/compiler.hpp>
+#include <array_list/detail/constexpr.hpp>
+#include <cassert>
+
+namespace cdt {
+namespace detail {
+
+/// Out of line, so the throw does not bloat the inlined caller
+template <typename _Exception>
+[[noreturn]] CDT_NOINLINE CDT_COLD void throw_error(const char* message) {
+    throw _Exception(message);
+}
+
+/// Throw _Exception if condition does not hold, always checked
+template <typename _Exception>
+CDT_CONSTEXPR inline void require(bool condition, const char* message) {
+    if (CDT_UNLIKELY(!condition)) {
+        throw_error<_Exception>(message);
+    }
+}
+
+/// Report a violated precondition according to CDT_CHECK_POLICY
+template <typename _Exception>
+CDT_CONSTEXPR inline void check(bool condition, const char* message) CDT_CHECK_NOEXCEPT {
+#if CDT_CHECK_POLICY == CDT_CHECKED
+    require<_Exception>(condition, message);
+#elif CDT_CHECK_POLICY == CDT_DEBUG_ASSERT
+    assert(condition && message);
+    (void)condition;
+    (void)message;
+#else
+    (void)condition;
+    (void)message;
+#endif
+}
+
+} // namespace detail
+} // Namespace cdt
@@ -0,0 +1,71 @@
+#pragma once
+#include <array_list/detail/constexpr.hpp>
+#include <cstdint>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/// \brief Compiler hints and bit scans, which map to GCC/Clang builtins and have fallbacks for MSVC.
+/// CDT_LIKELY and CDT_UNLIKELY mark the expected outcome of a condition, CDT_NOINLINE keeps a function out of line
+/// and CDT_COLD moves it away from the hot code.
+#if defined(__GNUC__) || defined(__clang__)
+#define CDT_LIKELY(condition) __builtin_expect(!!(condition), 1)
+#define CDT_UNLIKELY(condition) __builtin_expect(!!(condition), 0)
+#define CDT_NOINLINE __attribute__((noinline))
+#define CDT_COLD __attribute__((cold))
+#elif defined(_MSC_VER)
+#define CDT_LIKELY(condition) (condition)
+#define CDT_UNLIKELY(condition) (condition)
+#define CDT_NOINLINE __declspec(noinline)
+#define CDT_COLD
+#else
+#define CDT_LIKELY(condition) (condition)
+#define CDT_UNLIKELY(condition) (condition)
+#define CDT_NOINLINE
+#define CDT_COLD
+#endif
+
+namespace cdt {
+namespace detail {
+
+/// Index of the lowest set bit, x must not be zero
+CDT_CONSTEXPR inline unsigned count_trailing_zeros(uint32_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(x));
+#else
+#if defined(_MSC_VER)
+    if (!is_constant_evaluated()) {
+        unsigned long i;
+        _BitScanForward(&i, x);
+        return static_cast<unsigned>(i);
+    }
+#endif
+    unsigned i = 0;
+    for (; !(x & 1); x >>= 1) {
+        ++i;
+    }
+    return i;
+#endif
+}
+CDT_CONSTEXPR inline unsigned count_trailing_zeros(uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(x));
+#else
+    const uint32_t low = static_cast<uint32_t>(x);
+    return low != 0 ? count_trailing_zeros(low) : 32 + count_trailing_zeros(static_cast<uint32_t>(x >> 32));
+#endif
+}
+
+/// Number of set bits
+CDT_CONSTEXPR inline unsigned popcount(uint32_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_popcount(x));
+#else
+    x = x - ((x >> 1) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+    return static_cast<unsigned>((((x + (x >> 4)) & 0x0f0f0f0fu) * 0x01010101u) >> 24);
+#endif
+}
+
+} // namespace detail
+} // Namespace cdt
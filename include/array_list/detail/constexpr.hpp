@@ -0,0 +1,41 @@
+#pragma once
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/// \brief From C++20 on, the containers are usable in constant expressions, so tables can be built at compile time.
+/// CDT_CONSTEXPR expands to constexpr, if the standard library can construct objects in constant expressions,
+/// and to nothing otherwise. CDT_HAS_CONSTEXPR_CONTAINERS tells both cases apart.
+#if __cplusplus >= 202002L && defined(__cpp_lib_constexpr_dynamic_alloc) && defined(__cpp_lib_is_constant_evaluated)
+#define CDT_HAS_CONSTEXPR_CONTAINERS 1
+#define CDT_CONSTEXPR constexpr
+#else
+#define CDT_HAS_CONSTEXPR_CONTAINERS 0
+#define CDT_CONSTEXPR
+#endif
+
+namespace cdt {
+namespace detail {
+
+/// Whether the call is part of a constant evaluation, always false before C++20
+CDT_CONSTEXPR inline bool is_constant_evaluated() noexcept {
+#if CDT_HAS_CONSTEXPR_CONTAINERS
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+/// Placement new, which is also allowed in constant expressions
+template <typename _Tp, typename... _Args>
+CDT_CONSTEXPR _Tp* construct_at(_Tp* p, _Args&&... __args) {
+#if CDT_HAS_CONSTEXPR_CONTAINERS
+    return std::construct_at(p, std::forward<_Args>(__args)...);
+#else
+    return ::new (static_cast<void*>(p)) _Tp(std::forward<_Args>(__args)...);
+#endif
+}
+
+} // namespace detail
+} // Namespace cdt
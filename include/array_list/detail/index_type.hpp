@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace cdt {
+namespace detail {
+
+/// \brief Smallest unsigned integer type, that can hold all positions 0.._N.
+/// _N itself has to be representable, since containers use it as sentinel or end index.
+template <size_t _N>
+struct MinimalIndex {
+    typedef typename std::conditional<
+            _N <= std::numeric_limits<uint8_t>::max(), uint8_t,
+            typename std::conditional<
+                    _N <= std::numeric_limits<uint16_t>::max(), uint16_t,
+                    typename std::conditional<_N <= std::numeric_limits<uint32_t>::max(), uint32_t,
+                                              size_t>::type>::type>::type type;
+};
+
+} // namespace detail
+} // Namespace cdt
@@ -0,0 +1,217 @@
+#pragma once
+#include <array_list/detail/constexpr.hpp>
+#include <array_list/detail/uninitialized.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+
+namespace cdt {
+
+/// \brief ArrayList layout, which stores the links of a node next to its payload.
+/// Best suited for small payloads, where a node fits into a single cache line.
+struct InterleavedLayout {};
+
+/// \brief ArrayList layout, which stores links and payloads in separate arrays.
+/// Operations that only follow links (stepping, splicing, reordering) then only touch dense index arrays,
+/// which pays off for large payloads.
+struct SplitLayout {};
+
+namespace detail {
+
+/// Exchange n bytes, used for slots, which need not hold an object. Works on words, which the compiler vectorizes.
+inline void swap_bytes(void* a, void* b, size_t n) {
+    unsigned char* x = static_cast<unsigned char*>(a);
+    unsigned char* y = static_cast<unsigned char*>(b);
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t)) {
+        uint64_t u, v;
+        std::memcpy(&u, x + i, sizeof(u));
+        std::memcpy(&v, y + i, sizeof(v));
+        std::memcpy(x + i, &v, sizeof(v));
+        std::memcpy(y + i, &u, sizeof(u));
+    }
+    for (; i < n; i++) {
+        std::swap(x[i], y[i]);
+    }
+}
+
+/// \brief One bit per slot of an ArrayList, which is set while the slot holds an element.
+/// Allows to visit the elements in slot order a word at a time, without following links.
+/// Like the links, the words are left uninitialized. A word is zeroed once the allocator hands out its first slot,
+/// so all bits of slots, which have never been handed out, read as zero.
+template <size_t _N>
+class OccupancyBitmap {
+public:
+    enum : size_t { WORD_BITS = 64, WORDS = (_N + WORD_BITS - 1) / WORD_BITS };
+
+    CDT_CONSTEXPR OccupancyBitmap() {
+        if (is_constant_evaluated()) {
+            for (uint64_t& word : words) {
+                word = 0;
+            }
+        }
+    }
+    /// Mark slot i used, which is handed out for the first time
+    CDT_CONSTEXPR void mark_fresh(size_t i) {
+        if (i % WORD_BITS == 0) {
+            words[i / WORD_BITS] = 0;
+        }
+        mark_used(i);
+    }
+    CDT_CONSTEXPR void mark_used(size_t i) {
+        words[i / WORD_BITS] |= uint64_t(1) << (i % WORD_BITS);
+    }
+    CDT_CONSTEXPR void mark_free(size_t i) {
+        words[i / WORD_BITS] &= ~(uint64_t(1) << (i % WORD_BITS));
+    }
+    CDT_CONSTEXPR bool is_used(size_t i) const {
+        return (words[i / WORD_BITS] >> (i % WORD_BITS)) & 1;
+    }
+    /// Bits of the slots 64 * w..64 * w + 63
+    CDT_CONSTEXPR uint64_t used_bits(size_t w) const {
+        return words[w];
+    }
+    /// Mark exactly the slots 0..n-1 used
+    CDT_CONSTEXPR void mark_packed(size_t n) {
+        for (size_t w = 0; w < n / WORD_BITS; w++) {
+            words[w] = ~uint64_t(0);
+        }
+        if (n % WORD_BITS != 0) {
+            words[n / WORD_BITS] = (uint64_t(1) << (n % WORD_BITS)) - 1;
+        }
+    }
+
+protected:
+    /// Number of words, which hold the bits of the slots 0..n-1
+    static constexpr size_t words_for(size_t n) {
+        return (n + WORD_BITS - 1) / WORD_BITS;
+    }
+    void copy_bits(const OccupancyBitmap& other, size_t n) {
+        std::memcpy(words, other.words, words_for(n) * sizeof(uint64_t));
+    }
+    void swap_bits(OccupancyBitmap& other, size_t n) {
+        std::swap_ranges(words, words + words_for(n), other.words);
+    }
+
+private:
+    uint64_t words[WORDS];
+};
+
+/// \brief Node storage of an ArrayList.
+/// Slots 0.._N-1 hold elements, slot _N is the sentinel, which tracks begin and end.
+/// Links are left uninitialized, they are set whenever a node is linked into the list.
+/// Only in constant expressions, which must not contain uninitialized values, they are zeroed up front.
+/// Payloads are only constructed while the node is part of the list.
+/// The storage also carries the occupancy bitmap, so that snapshots and raw copies take it along with the slots.
+template <typename _Tp, size_t _N, typename _Position, typename _Layout>
+class ListStorage;
+
+template <typename _Tp, size_t _N, typename _Position>
+class ListStorage<_Tp, _N, _Position, InterleavedLayout> : public OccupancyBitmap<_N> {
+public:
+    CDT_CONSTEXPR ListStorage() {
+        if (is_constant_evaluated()) {
+            for (Node& node : nodes) {
+                node.next = node.prev = 0;
+            }
+        }
+    }
+    CDT_CONSTEXPR _Position& next(_Position i) {
+        return nodes[i].next;
+    }
+    CDT_CONSTEXPR const _Position& next(_Position i) const {
+        return nodes[i].next;
+    }
+    CDT_CONSTEXPR _Position& prev(_Position i) {
+        return nodes[i].prev;
+    }
+    CDT_CONSTEXPR const _Position& prev(_Position i) const {
+        return nodes[i].prev;
+    }
+    CDT_CONSTEXPR UninitializedStorage<_Tp>& payload(_Position i) {
+        return nodes[i].payload;
+    }
+    CDT_CONSTEXPR const UninitializedStorage<_Tp>& payload(_Position i) const {
+        return nodes[i].payload;
+    }
+    /// Copy the slots 0..n-1, their bits and the sentinel of other as raw bytes, only for trivially copyable _Tp
+    void copy_prefix(const ListStorage& other, size_t n) {
+        std::memcpy(static_cast<void*>(nodes), other.nodes, n * sizeof(Node));
+        this->copy_bits(other, n);
+        nodes[_N].next = other.nodes[_N].next;
+        nodes[_N].prev = other.nodes[_N].prev;
+    }
+    /// Exchange the slots 0..n-1, their bits and the sentinel with other as raw bytes, only for trivially copyable _Tp
+    void swap_prefix(ListStorage& other, size_t n) {
+        swap_bytes(nodes, other.nodes, n * sizeof(Node));
+        this->swap_bits(other, n);
+        std::swap(nodes[_N].next, other.nodes[_N].next);
+        std::swap(nodes[_N].prev, other.nodes[_N].prev);
+    }
+
+private:
+    struct Node {
+        _Position next;
+        _Position prev;
+        UninitializedStorage<_Tp> payload;
+    };
+
+    Node nodes[_N + 1]; // We store one element more in order to track begin and end
+};
+
+template <typename _Tp, size_t _N, typename _Position>
+class ListStorage<_Tp, _N, _Position, SplitLayout> : public OccupancyBitmap<_N> {
+public:
+    CDT_CONSTEXPR ListStorage() {
+        if (is_constant_evaluated()) {
+            for (size_t i = 0; i <= _N; i++) {
+                nexts[i] = prevs[i] = 0;
+            }
+        }
+    }
+    CDT_CONSTEXPR _Position& next(_Position i) {
+        return nexts[i];
+    }
+    CDT_CONSTEXPR const _Position& next(_Position i) const {
+        return nexts[i];
+    }
+    CDT_CONSTEXPR _Position& prev(_Position i) {
+        return prevs[i];
+    }
+    CDT_CONSTEXPR const _Position& prev(_Position i) const {
+        return prevs[i];
+    }
+    CDT_CONSTEXPR UninitializedStorage<_Tp>& payload(_Position i) {
+        return payloads[i];
+    }
+    CDT_CONSTEXPR const UninitializedStorage<_Tp>& payload(_Position i) const {
+        return payloads[i];
+    }
+    /// Copy the slots 0..n-1, their bits and the sentinel of other as raw bytes, only for trivially copyable _Tp
+    void copy_prefix(const ListStorage& other, size_t n) {
+        std::memcpy(nexts, other.nexts, n * sizeof(_Position));
+        std::memcpy(prevs, other.prevs, n * sizeof(_Position));
+        std::memcpy(static_cast<void*>(payloads), other.payloads, n * sizeof(UninitializedStorage<_Tp>));
+        this->copy_bits(other, n);
+        nexts[_N] = other.nexts[_N];
+        prevs[_N] = other.prevs[_N];
+    }
+    /// Exchange the slots 0..n-1, their bits and the sentinel with other as raw bytes, only for trivially copyable _Tp
+    void swap_prefix(ListStorage& other, size_t n) {
+        std::swap_ranges(nexts, nexts + n, other.nexts);
+        std::swap_ranges(prevs, prevs + n, other.prevs);
+        swap_bytes(payloads, other.payloads, n * sizeof(UninitializedStorage<_Tp>));
+        this->swap_bits(other, n);
+        std::swap(nexts[_N], other.nexts[_N]);
+        std::swap(prevs[_N], other.prevs[_N]);
+    }
+
+private:
+    _Position nexts[_N + 1]; // We store one link more in order to track begin and end
+    _Position prevs[_N + 1];
+    UninitializedStorage<_Tp> payloads[_N]; // The sentinel carries no payload
+};
+
+} // namespace detail
+} // Namespace cdt
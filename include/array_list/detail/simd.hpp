@@ -0,0 +1,328 @@
+#pragma once
+#include <algorithm>
+#include <array_list/detail/compiler.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace cdt {
+namespace detail {
+namespace simd {
+
+/// \brief Search and reduction kernels over contiguous arrays.
+/// 32 bit integers and floats are processed in vector registers, AVX2 or SSE2 is chosen at compile time.
+/// Removal (compress) and min/max are only vectorized with AVX2, which CDT_SIMD_COMPRESS and CDT_SIMD_MINMAX
+/// tell within this header. All other types, and builds without either instruction set, use the scalar fallback.
+
+#if defined(__AVX2__)
+constexpr size_t lanes = 8;
+
+/// Bit i is set, if lane i of the block starting at p equals value
+inline unsigned match_mask(const int32_t* p, int32_t value) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, _mm256_set1_epi32(value))));
+}
+inline unsigned match_mask(const uint32_t* p, uint32_t value) {
+    return match_mask(reinterpret_cast<const int32_t*>(p), static_cast<int32_t>(value));
+}
+inline unsigned match_mask(const float* p, float value) {
+    return _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p), _mm256_set1_ps(value), _CMP_EQ_OQ));
+}
+
+/// Smallest and largest value of a non-empty array
+inline int32_t min_value(const int32_t* first, const int32_t* last) {
+    int32_t result = *first;
+    if (last - first >= static_cast<ptrdiff_t>(lanes)) {
+        __m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        for (first += lanes; last - first >= static_cast<ptrdiff_t>(lanes); first += lanes) {
+            acc = _mm256_min_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first)));
+        }
+        alignas(32) int32_t reduced[lanes];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(reduced), acc);
+        result = *std::min_element(reduced, reduced + lanes);
+    }
+    for (; first != last; ++first) {
+        result = std::min(result, *first);
+    }
+    return result;
+}
+inline int32_t max_value(const int32_t* first, const int32_t* last) {
+    int32_t result = *first;
+    if (last - first >= static_cast<ptrdiff_t>(lanes)) {
+        __m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        for (first += lanes; last - first >= static_cast<ptrdiff_t>(lanes); first += lanes) {
+            acc = _mm256_max_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first)));
+        }
+        alignas(32) int32_t reduced[lanes];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(reduced), acc);
+        result = *std::max_element(reduced, reduced + lanes);
+    }
+    for (; first != last; ++first) {
+        result = std::max(result, *first);
+    }
+    return result;
+}
+inline uint32_t min_value(const uint32_t* first, const uint32_t* last) {
+    uint32_t result = *first;
+    if (last - first >= static_cast<ptrdiff_t>(lanes)) {
+        __m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        for (first += lanes; last - first >= static_cast<ptrdiff_t>(lanes); first += lanes) {
+            acc = _mm256_min_epu32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first)));
+        }
+        alignas(32) uint32_t reduced[lanes];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(reduced), acc);
+        result = *std::min_element(reduced, reduced + lanes);
+    }
+    for (; first != last; ++first) {
+        result = std::min(result, *first);
+    }
+    return result;
+}
+inline uint32_t max_value(const uint32_t* first, const uint32_t* last) {
+    uint32_t result = *first;
+    if (last - first >= static_cast<ptrdiff_t>(lanes)) {
+        __m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        for (first += lanes; last - first >= static_cast<ptrdiff_t>(lanes); first += lanes) {
+            acc = _mm256_max_epu32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first)));
+        }
+        alignas(32) uint32_t reduced[lanes];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(reduced), acc);
+        result = *std::max_element(reduced, reduced + lanes);
+    }
+    for (; first != last; ++first) {
+        result = std::max(result, *first);
+    }
+    return result;
+}
+
+/// Lane permutations, which move the lanes selected by an 8 bit mask to the front
+struct CompressTable {
+    constexpr CompressTable() : indices() {
+        for (unsigned mask = 0; mask < 256; mask++) {
+            unsigned k = 0;
+            for (unsigned lane = 0; lane < lanes; lane++) {
+                if (mask & (1u << lane)) {
+                    indices[mask][k++] = lane;
+                }
+            }
+        }
+    }
+    uint32_t indices[256][lanes];
+};
+
+/// Write the lanes of the block at in, which are selected by keep, densely to out. Returns the number of lanes written.
+/// Writes a whole block, so out must not be behind in.
+template <typename _Tp>
+inline size_t compress_block(const _Tp* in, _Tp* out, unsigned keep) {
+    static_assert(sizeof(_Tp) == 4, "Only 32 bit lanes can be compressed.");
+    static const CompressTable table;
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+    __m256i permutation = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(table.indices[keep]));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permutevar8x32_epi32(v, permutation));
+    return popcount(keep);
+}
+#define CDT_SIMD_COMPRESS 1
+#define CDT_SIMD_MINMAX 1
+
+#elif defined(__SSE2__)
+constexpr size_t lanes = 4;
+
+inline unsigned match_mask(const int32_t* p, int32_t value) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, _mm_set1_epi32(value))));
+}
+inline unsigned match_mask(const uint32_t* p, uint32_t value) {
+    return match_mask(reinterpret_cast<const int32_t*>(p), static_cast<int32_t>(value));
+}
+inline unsigned match_mask(const float* p, float value) {
+    return _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p), _mm_set1_ps(value)));
+}
+#endif
+
+/// Whether _Tp has vectorized kernels in this build
+template <typename _Tp>
+struct is_vectorized
+        : std::integral_constant<bool,
+#if defined(__AVX2__) || defined(__SSE2__)
+                                 std::is_same<_Tp, int32_t>::value || std::is_same<_Tp, uint32_t>::value ||
+                                         std::is_same<_Tp, float>::value
+#else
+                                 false
+#endif
+                                 > {
+};
+
+/// Whether min_value()/max_value() are vectorized for _Tp in this build
+template <typename _Tp>
+struct is_vectorized_minmax
+        : std::integral_constant<bool,
+#if defined(CDT_SIMD_MINMAX)
+                                 std::is_same<_Tp, int32_t>::value || std::is_same<_Tp, uint32_t>::value
+#else
+                                 false
+#endif
+                                 > {
+};
+
+// find:
+template <typename _Tp>
+const _Tp* find(const _Tp* first, const _Tp* last, const _Tp& value, std::false_type) {
+    return std::find(first, last, value);
+}
+#if defined(__AVX2__) || defined(__SSE2__)
+template <typename _Tp>
+const _Tp* find(const _Tp* first, const _Tp* last, const _Tp& value, std::true_type) {
+    for (; last - first >= static_cast<ptrdiff_t>(lanes); first += lanes) {
+        unsigned mask = match_mask(first, value);
+        if (mask) {
+            return first + count_trailing_zeros(mask);
+        }
+    }
+    return std::find(first, last, value);
+}
+#endif
+/// Pointer to the first element equal to value, last if there is none
+template <typename _Tp>
+const _Tp* find(const _Tp* first, const _Tp* last, const _Tp& value) {
+    return find(first, last, value, is_vectorized<_Tp>());
+}
+
+// count:
+template <typename _Tp>
+size_t count(const _Tp* first, const _Tp* last, const _Tp& value, std::false_type) {
+    return std::count(first, last, value);
+}
+#if defined(__AVX2__) || defined(__SSE2__)
+template <typename _Tp>
+size_t count(const _Tp* first, const _Tp* last, const _Tp& value, std::true_type) {
+    size_t result = 0;
+    for (; last - first >= static_cast<ptrdiff_t>(lanes); first += lanes) {
+        result += popcount(match_mask(first, value));
+    }
+    return result + std::count(first, last, value);
+}
+#endif
+/// Number of elements equal to value
+template <typename _Tp>
+size_t count(const _Tp* first, const _Tp* last, const _Tp& value) {
+    return count(first, last, value, is_vectorized<_Tp>());
+}
+
+// min_element/max_element:
+template <typename _Tp>
+const _Tp* min_element_impl(const _Tp* first, const _Tp* last, std::false_type) {
+    return std::min_element(first, last);
+}
+template <typename _Tp>
+const _Tp* max_element_impl(const _Tp* first, const _Tp* last, std::false_type) {
+    return std::max_element(first, last);
+}
+#if defined(CDT_SIMD_MINMAX)
+template <typename _Tp>
+const _Tp* min_element_impl(const _Tp* first, const _Tp* last, std::true_type) {
+    return first == last ? last : simd::find(first, last, min_value(first, last));
+}
+template <typename _Tp>
+const _Tp* max_element_impl(const _Tp* first, const _Tp* last, std::true_type) {
+    return first == last ? last : simd::find(first, last, max_value(first, last));
+}
+#endif
+/// Pointer to the first smallest element, last if the range is empty
+template <typename _Tp>
+const _Tp* min_element(const _Tp* first, const _Tp* last) {
+    return min_element_impl(first, last, is_vectorized_minmax<_Tp>());
+}
+/// Pointer to the first largest element, last if the range is empty
+template <typename _Tp>
+const _Tp* max_element(const _Tp* first, const _Tp* last) {
+    return max_element_impl(first, last, is_vectorized_minmax<_Tp>());
+}
+
+// remove:
+/// Compact the elements, for which pred is false, to the front, preserving their order. Returns the new end.
+/// Each element is written unconditionally and the output only advances for kept elements, which avoids
+/// unpredictable branches.
+template <typename _Tp, class _Predicate>
+_Tp* remove_if(_Tp* first, _Tp* last, _Predicate pred) {
+    first = std::find_if(first, last, pred);
+    if (first == last) {
+        return last;
+    }
+    _Tp* out = first;
+    for (++first; first != last; ++first) {
+        const bool keep = !pred(*first);
+        *out = std::move(*first);
+        out += keep;
+    }
+    return out;
+}
+
+template <typename _Tp>
+_Tp* remove(_Tp* first, _Tp* last, const _Tp& value, std::false_type) {
+    return simd::remove_if(first, last, [&value](const _Tp& x) { return x == value; });
+}
+#if defined(CDT_SIMD_COMPRESS)
+template <typename _Tp>
+_Tp* remove(_Tp* first, _Tp* last, const _Tp& value, std::true_type) {
+    _Tp* out = first;
+    for (; last - first >= static_cast<ptrdiff_t>(lanes); first += lanes) {
+        out += compress_block(first, out, ~match_mask(first, value) & 0xffu);
+    }
+    for (; first != last; ++first) {
+        const bool keep = !(*first == value);
+        *out = *first;
+        out += keep;
+    }
+    return out;
+}
+#endif
+/// Compact the elements not equal to value to the front, preserving their order. Returns the new end.
+template <typename _Tp>
+_Tp* remove(_Tp* first, _Tp* last, const _Tp& value) {
+#if defined(CDT_SIMD_COMPRESS)
+    return remove(first, last, value, is_vectorized<_Tp>());
+#else
+    return remove(first, last, value, std::false_type());
+#endif
+}
+
+// control byte groups:
+/// FixedHashMap probes its control bytes in aligned groups of this many bytes
+constexpr size_t group_width = 16;
+#if defined(__SSE2__)
+/// Bit i is set, if byte i of the group equals value
+inline unsigned match_byte(const int8_t* group, int8_t value) {
+    __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(group));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(value)));
+}
+/// Bit i is set, if byte i of the group is negative
+inline unsigned match_negative(const int8_t* group) {
+    return _mm_movemask_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(group)));
+}
+#else
+inline unsigned match_byte(const int8_t* group, int8_t value) {
+    unsigned mask = 0;
+    for (size_t i = 0; i < group_width; i++) {
+        mask |= unsigned(group[i] == value) << i;
+    }
+    return mask;
+}
+inline unsigned match_negative(const int8_t* group) {
+    unsigned mask = 0;
+    for (size_t i = 0; i < group_width; i++) {
+        mask |= unsigned(group[i] < 0) << i;
+    }
+    return mask;
+}
+#endif
+
+} // namespace simd
+} // namespace detail
+} // Namespace cdt
+
+#undef CDT_SIMD_COMPRESS
+#undef CDT_SIMD_MINMAX
@@ -0,0 +1,116 @@
+#pragma once
+#include <algorithm>
+#include <array_list/detail/index_type.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace cdt {
+namespace detail {
+
+/// \brief Generational slots of the containers, which hand out handles to densely stored elements.
+/// A handle holds the index of a slot and the generation of that slot. Each slot in use points to the position of
+/// its element in the dense array, and owners maps each position back to its slot.
+/// Released slots are chained into a free list through their position, and untouched slots are taken from a
+/// watermark like in ArrayList, so nothing has to be initialized up front.
+/// Each slot counts its generation up on every acquisition and release, so slots in use have odd generations.
+/// Handles of released slots therefore never match again, until the 32 bit generation wraps around.
+/// _Owner only tells the handles of different containers apart.
+template <size_t _N, typename _Owner>
+class SlotTable {
+public:
+    typedef size_t size_type;
+    typedef typename MinimalIndex<_N>::type position_type;
+    typedef uint32_t generation_type;
+
+    /// Stable reference to an element. A default constructed handle refers to no element.
+    struct Handle {
+        Handle() : index(_N), generation(0){};
+        Handle(position_type i, generation_type g) : index(i), generation(g){};
+        bool operator==(const Handle& other) const {
+            return index == other.index && generation == other.generation;
+        }
+        bool operator!=(const Handle& other) const {
+            return !(*this == other);
+        }
+
+        position_type index;
+        generation_type generation;
+    };
+
+    SlotTable() : free_head(_N), untouched(0){};
+
+    /// Take a slot for a new element, its position has to be set with place() before it is used
+    position_type acquire() noexcept {
+        position_type i;
+        if (free_head != _N) {
+            i = free_head;
+            free_head = slots[i].position;
+        } else {
+            i = untouched++;
+            slots[i].generation = 0;
+        }
+        ++slots[i].generation;
+        return i;
+    }
+    /// Invalidate the handles of slot i and put it on the free list
+    void release(position_type i) noexcept {
+        ++slots[i].generation;
+        slots[i].position = free_head;
+        free_head = i;
+    }
+    /// Release the slots of the elements at the positions 0..n-1
+    void release_all(size_type n) noexcept {
+        for (size_type k = 0; k < n; k++) {
+            release(owners[k]);
+        }
+    }
+    /// Record that position k holds the element of slot i
+    void place(size_type k, position_type i) noexcept {
+        owners[k] = i;
+        slots[i].position = static_cast<position_type>(k);
+    }
+
+    /// Whether handle refers to a slot in use, stale and default constructed handles do not
+    bool contains(Handle handle) const noexcept {
+        return handle.index < untouched && (handle.generation & 1) &&
+               slots[handle.index].generation == handle.generation;
+    }
+    /// Position of the element of a slot in use
+    size_type position(Handle handle) const noexcept {
+        return slots[handle.index].position;
+    }
+    /// Slot of the element at position k
+    position_type owner(size_type k) const noexcept {
+        return owners[k];
+    }
+    /// Current handle of slot i, respectively of the element at position k
+    Handle handle(position_type i) const noexcept {
+        return Handle(i, slots[i].generation);
+    }
+    Handle handle_at(size_type k) const noexcept {
+        return handle(owners[k]);
+    }
+
+    /// Take over the slots of other, which hold n elements. Only the slots in use are copied.
+    void copy_from(const SlotTable& other, size_type n) noexcept {
+        free_head = other.free_head;
+        untouched = other.untouched;
+        std::copy(other.slots, other.slots + other.untouched, slots);
+        std::copy(other.owners, other.owners + n, owners);
+    }
+
+private:
+    /// A slot in use points to its element, a released slot to the next released slot
+    struct Slot {
+        position_type position;
+        generation_type generation;
+    };
+
+    position_type owners[_N]; ///< Slot of the element at each position
+    Slot slots[_N];
+    position_type free_head; ///< First released slot, _N if there is none
+    position_type untouched; ///< Slots from here on have never been used
+};
+
+} // namespace detail
+} // Namespace cdt
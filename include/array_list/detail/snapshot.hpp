@@ -0,0 +1,96 @@
+#pragma once
+#include <array_list/detail/check_policy.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace cdt {
+
+/// \brief Header in front of every container snapshot.
+/// A snapshot is the header followed by a raw image of the container's memory, aligned for the stored type.
+/// The header records everything the image depends on, so a snapshot is only restored into the same container type
+/// on a machine with the same byte order. The magic number does not match on a machine of different byte order.
+/// Element types of equal size and alignment are not told apart.
+struct SnapshotHeader {
+    enum : uint32_t {
+        MAGIC = 0x53544443, ///< "CDTS" in little endian byte order
+        VERSION = 2         ///< Incremented on every change of the format
+    };
+    enum : uint8_t { FIXED_VECTOR = 1, ARRAY_LIST_INTERLEAVED = 2, ARRAY_LIST_SPLIT = 3 };
+
+    uint32_t magic;
+    uint16_t version;
+    uint8_t container;    ///< Kind and layout of the container
+    uint8_t index_width;  ///< Bytes per index
+    uint32_t value_size;  ///< sizeof(_Tp)
+    uint32_t value_align; ///< alignof(_Tp)
+    uint64_t capacity;    ///< _N
+    uint64_t size;        ///< Number of elements
+    uint64_t free_head;   ///< Allocator state of ArrayList, unused for FixedVector
+    uint64_t untouched;
+    uint64_t flags; ///< Bit 0: ArrayList is contiguous
+};
+
+namespace detail {
+
+/// Offset of the image behind the header, so that the image is aligned to alignment in an aligned buffer
+constexpr size_t snapshot_offset(size_t alignment) {
+    return (sizeof(SnapshotHeader) + alignment - 1) / alignment * alignment;
+}
+
+/// Header of a container, the container state is left zeroed
+template <typename _Tp, size_t _N, typename _Position>
+SnapshotHeader snapshot_header(uint8_t container) {
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = SnapshotHeader::MAGIC;
+    header.version = SnapshotHeader::VERSION;
+    header.container = container;
+    header.index_width = sizeof(_Position);
+    header.value_size = sizeof(_Tp);
+    header.value_align = alignof(_Tp);
+    header.capacity = _N;
+    return header;
+}
+
+/// Write header and image into buffer, returns the number of written bytes
+inline size_t write_snapshot(void* buffer, size_t bytes, const SnapshotHeader& header, const void* image,
+                             size_t offset, size_t image_size) {
+    require<std::length_error>(bytes >= offset + image_size, "Buffer is too small for the snapshot.");
+    unsigned char* out = static_cast<unsigned char*>(buffer);
+    std::memcpy(out, &header, sizeof(header));
+    std::memset(out + sizeof(header), 0, offset - sizeof(header));
+    std::memcpy(out + offset, image, image_size);
+    return offset + image_size;
+}
+
+/// Read the header of a snapshot and check that it was taken from a container like expected.
+/// Throws std::invalid_argument otherwise.
+inline SnapshotHeader read_snapshot_header(const void* buffer, size_t bytes, const SnapshotHeader& expected) {
+    require<std::invalid_argument>(bytes >= sizeof(SnapshotHeader), "Snapshot is truncated.");
+    SnapshotHeader header;
+    std::memcpy(&header, buffer, sizeof(header));
+    require<std::invalid_argument>(header.magic == SnapshotHeader::MAGIC, "Buffer holds no snapshot.");
+    require<std::invalid_argument>(header.version == SnapshotHeader::VERSION, "Snapshot version is not supported.");
+    require<std::invalid_argument>(header.container == expected.container && header.index_width == expected.index_width &&
+                                           header.value_size == expected.value_size &&
+                                           header.value_align == expected.value_align &&
+                                           header.capacity == expected.capacity,
+                                   "Snapshot was taken from a different container type.");
+    require<std::invalid_argument>(header.size <= header.capacity, "Snapshot is corrupt.");
+    return header;
+}
+
+/// Image of a snapshot, which is used in place. Throws std::invalid_argument if it is truncated or misaligned.
+inline const void* snapshot_image(const void* buffer, size_t bytes, size_t offset, size_t image_size,
+                                  size_t alignment) {
+    require<std::invalid_argument>(bytes >= offset + image_size, "Snapshot is truncated.");
+    const unsigned char* image = static_cast<const unsigned char*>(buffer) + offset;
+    require<std::invalid_argument>(reinterpret_cast<uintptr_t>(image) % alignment == 0,
+                                   "Snapshot buffer is misaligned.");
+    return image;
+}
+
+} // namespace detail
+} // Namespace cdt
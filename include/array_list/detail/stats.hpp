@@ -0,0 +1,115 @@
+#pragma once
+
+/// \brief Usage statistics of ArrayList and FixedVector, to size the capacities from real traffic.
+/// Recording is enabled by defining CDT_ENABLE_STATS to 1 before including any container.
+/// When disabled (default), the recorder is an empty base class and every recording call is a no-op,
+/// so neither the size nor the speed of the containers changes. stats() then always reports zeros.
+/// Like CDT_CHECK_POLICY, all translation units of a program have to agree on the setting.
+#ifndef CDT_ENABLE_STATS
+#define CDT_ENABLE_STATS 0
+#endif
+
+#include <array_list/detail/constexpr.hpp>
+#include <cstddef>
+
+namespace cdt {
+
+/// Counters of one container object, they start at zero on construction and are not copied along with the elements
+struct UsageStats {
+    CDT_CONSTEXPR UsageStats()
+        : high_water_mark(0), inserts(0), erases(0), overflows(0), recycled(0), scans(0), scan_steps(0),
+          max_scan_length(0){};
+
+    size_t high_water_mark; ///< Largest size reached
+    size_t inserts;         ///< Elements inserted
+    size_t erases;          ///< Elements erased, including clear()
+    size_t overflows;       ///< Insertions, which did not fit into the capacity
+    size_t recycled;        ///< Insertions into a slot taken from the free list (ArrayList only)
+    size_t scans;           ///< Lookups by index or of the index of an iterator (ArrayList only)
+    size_t scan_steps;      ///< Links followed by all scans together, scan_steps / scans is the mean scan length
+    size_t max_scan_length; ///< Links followed by the longest scan
+};
+
+namespace detail {
+
+#if CDT_ENABLE_STATS
+/// Records the usage of a container. Counters are mutable, so that const lookups can record their scans.
+/// Nothing is recorded while constant evaluated.
+class UsageRecorder {
+protected:
+    CDT_CONSTEXPR UsageRecorder(){};
+    CDT_CONSTEXPR UsageRecorder(const UsageRecorder&){};
+    CDT_CONSTEXPR UsageRecorder& operator=(const UsageRecorder&) {
+        return *this;
+    }
+
+    /// Count n inserted elements, which grew the container to size_after
+    CDT_CONSTEXPR void record_insert(size_t size_after, size_t n = 1) const noexcept {
+        if (is_constant_evaluated()) {
+            return;
+        }
+        counters.inserts += n;
+        counters.high_water_mark = size_after > counters.high_water_mark ? size_after : counters.high_water_mark;
+    }
+    CDT_CONSTEXPR void record_recycled() const noexcept {
+        if (!is_constant_evaluated()) {
+            ++counters.recycled;
+        }
+    }
+    CDT_CONSTEXPR void record_erase(size_t n = 1) const noexcept {
+        if (!is_constant_evaluated()) {
+            counters.erases += n;
+        }
+    }
+    /// Count an overflow, if n more elements do not fit
+    CDT_CONSTEXPR void record_overflow(size_t size, size_t n, size_t capacity) const noexcept {
+        if (!is_constant_evaluated() && n > capacity - size) {
+            ++counters.overflows;
+        }
+    }
+    CDT_CONSTEXPR void record_scan(size_t steps) const noexcept {
+        if (is_constant_evaluated()) {
+            return;
+        }
+        ++counters.scans;
+        counters.scan_steps += steps;
+        counters.max_scan_length = steps > counters.max_scan_length ? steps : counters.max_scan_length;
+    }
+
+    UsageStats usage() const noexcept {
+        return counters;
+    }
+    /// Start over, the high-water mark restarts from the current size
+    void reset_usage(size_t size) noexcept {
+        counters = UsageStats();
+        counters.high_water_mark = size;
+    }
+
+private:
+    mutable UsageStats counters;
+};
+#else
+/// Disabled recorder, it takes no space as empty base class and all calls compile to nothing
+class UsageRecorder {
+protected:
+    CDT_CONSTEXPR void record_insert(size_t, size_t = 1) const noexcept {
+    }
+    CDT_CONSTEXPR void record_recycled() const noexcept {
+    }
+    CDT_CONSTEXPR void record_erase(size_t = 1) const noexcept {
+    }
+    CDT_CONSTEXPR void record_overflow(size_t, size_t, size_t) const noexcept {
+    }
+    CDT_CONSTEXPR void record_scan(size_t) const noexcept {
+    }
+
+    UsageStats usage() const noexcept {
+        return UsageStats();
+    }
+    void reset_usage(size_t) noexcept {
+    }
+};
+#endif
+
+} // namespace detail
+} // Namespace cdt
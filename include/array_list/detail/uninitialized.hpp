@@ -0,0 +1,88 @@
+#pragma once
+#include <array_list/detail/constexpr.hpp>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cdt {
+namespace detail {
+
+/// \brief Raw, correctly aligned storage for a single object.
+/// The object is neither constructed nor destroyed implicitly, this is up to the owning container.
+/// For trivially destructible types the storage itself stays trivially destructible.
+/// Without an object, the empty member is active, as constant expressions must not contain a union without one.
+template <typename _Tp, bool = std::is_trivially_destructible<_Tp>::value>
+union UninitializedStorage {
+    CDT_CONSTEXPR UninitializedStorage() : empty(){};
+
+    template <typename... _Args>
+    CDT_CONSTEXPR void construct(_Args&&... __args) {
+        detail::construct_at(&value, std::forward<_Args>(__args)...);
+    }
+    CDT_CONSTEXPR void destroy() {
+    }
+
+    struct Empty {
+    } empty;
+    _Tp value;
+};
+
+template <typename _Tp>
+union UninitializedStorage<_Tp, false> {
+    CDT_CONSTEXPR UninitializedStorage() : empty(){};
+    CDT_CONSTEXPR ~UninitializedStorage(){};
+
+    template <typename... _Args>
+    CDT_CONSTEXPR void construct(_Args&&... __args) {
+        detail::construct_at(&value, std::forward<_Args>(__args)...);
+    }
+    CDT_CONSTEXPR void destroy() {
+        value.~_Tp();
+        if (is_constant_evaluated()) {
+            detail::construct_at(&empty);
+        }
+    }
+
+    struct Empty {
+    } empty;
+    _Tp value;
+};
+
+/// \brief Raw, contiguous storage for _N objects, which are constructed and destroyed explicitly.
+/// Objects are addressed through a plain pointer, so the storage can back pointer iterators.
+template <typename _Tp, size_t _N, bool = std::is_trivial<_Tp>::value>
+struct UninitializedArray {
+    _Tp* ptr() {
+        return reinterpret_cast<_Tp*>(&raw[0]);
+    }
+    const _Tp* ptr() const {
+        return reinterpret_cast<const _Tp*>(&raw[0]);
+    }
+
+    typename std::aligned_storage<sizeof(_Tp), alignof(_Tp)>::type raw[_N];
+};
+
+/// Trivial types need no construction, so a plain (default initialized) array does the job.
+/// Constant expressions must not contain uninitialized values, so only then the array is zeroed.
+template <typename _Tp, size_t _N>
+struct UninitializedArray<_Tp, _N, true> {
+    CDT_CONSTEXPR UninitializedArray() {
+        if (is_constant_evaluated()) {
+            for (_Tp& v : values) {
+                v = _Tp();
+            }
+        }
+    }
+    CDT_CONSTEXPR _Tp* ptr() {
+        return &values[0];
+    }
+    CDT_CONSTEXPR const _Tp* ptr() const {
+        return &values[0];
+    }
+
+    _Tp values[_N];
+};
+
+} // namespace detail
+} // Namespace cdt
@@ -0,0 +1,107 @@
+#pragma once
+#include <algorithm>
+#include <array_list/detail/check_policy.hpp>
+#include <array_list/detail/constexpr.hpp>
+#include <array_list/detail/simd.hpp>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+namespace cdt {
+namespace detail {
+
+/// \brief Search and removal of the vector containers, which keep their elements gapless in [begin(), end()).
+/// _Derived provides begin(), end() and size(), and truncate(new_end), which destroys the elements from new_end on
+/// and returns their number. Search and reduction are vectorized for 32 bit integers and floats.
+template <typename _Derived, typename _Tp>
+class VectorAlgorithms {
+public:
+    typedef _Tp* iterator;
+    typedef const _Tp* const_iterator;
+
+    /// Find first element equal to x, end() if there is none
+    CDT_CONSTEXPR iterator find(const _Tp& x) {
+        return const_cast<iterator>(static_cast<const VectorAlgorithms*>(this)->find(x));
+    }
+    CDT_CONSTEXPR const_iterator find(const _Tp& x) const {
+        if (is_constant_evaluated()) {
+            return std::find(self().begin(), self().end(), x);
+        }
+        return simd::find(self().begin(), self().end(), x);
+    }
+    /// Number of elements equal to x
+    CDT_CONSTEXPR size_t count(const _Tp& x) const {
+        if (is_constant_evaluated()) {
+            return std::count(self().begin(), self().end(), x);
+        }
+        return simd::count(self().begin(), self().end(), x);
+    }
+    /// Whether any element equals x
+    CDT_CONSTEXPR bool contains(const _Tp& x) const {
+        return find(x) != self().end();
+    }
+    /// First smallest element, end() if the vector is empty
+    iterator min_element() {
+        return const_cast<iterator>(static_cast<const VectorAlgorithms*>(this)->min_element());
+    }
+    const_iterator min_element() const {
+        return simd::min_element(self().begin(), self().end());
+    }
+    /// First largest element, end() if the vector is empty
+    iterator max_element() {
+        return const_cast<iterator>(static_cast<const VectorAlgorithms*>(this)->max_element());
+    }
+    const_iterator max_element() const {
+        return simd::max_element(self().begin(), self().end());
+    }
+
+    /// Erase all elements equal to x in a single pass, the remaining elements keep their order.
+    /// Returns the number of erased elements.
+    size_t remove(const _Tp& x) {
+        return self().truncate(simd::remove(self().begin(), self().end(), x));
+    }
+    /// Erase all elements for which pred is true in a single pass, the remaining elements keep their order.
+    /// Returns the number of erased elements.
+    template <class _Predicate>
+    size_t erase_if(_Predicate pred) {
+        return self().truncate(simd::remove_if(self().begin(), self().end(), pred));
+    }
+    /// Erase all elements for which pred is true in a single pass, filling each gap with the last element like erase().
+    /// Moves fewer elements than erase_if(), but does not preserve order. Returns the number of erased elements.
+    template <class _Predicate>
+    CDT_CONSTEXPR size_t erase_if_unordered(_Predicate pred) {
+        iterator last = self().end();
+        iterator it = self().begin();
+        while (it != last) {
+            if (pred(*it)) {
+                if (it != --last) {
+                    *it = std::move(*last); // Check the moved element in the next round
+                }
+            } else {
+                ++it;
+            }
+        }
+        return self().truncate(last);
+    }
+
+protected:
+    /// Check whether iterator is within bounds
+    CDT_CONSTEXPR void assert_valid(const_iterator it) const CDT_CHECK_NOEXCEPT {
+        check<std::out_of_range>(it >= self().begin() && it < self().end(), "Out of range error.");
+    }
+    /// Check whether index is within bounds
+    CDT_CONSTEXPR void assert_valid(size_t idx) const CDT_CHECK_NOEXCEPT {
+        check<std::out_of_range>(idx < self().size(), "Out of range error.");
+    }
+
+private:
+    CDT_CONSTEXPR _Derived& self() noexcept {
+        return static_cast<_Derived&>(*this);
+    }
+    CDT_CONSTEXPR const _Derived& self() const noexcept {
+        return static_cast<const _Derived&>(*this);
+    }
+};
+
+} // namespace detail
+} // Namespace cdt
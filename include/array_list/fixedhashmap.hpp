@@ -0,0 +1,472 @@
+#pragma once
+#include <array_list/detail/check_policy.hpp>
+#include <array_list/detail/compiler.hpp>
+#include <array_list/detail/simd.hpp>
+#include <array_list/detail/uninitialized.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace cdt {
+
+/// \brief An unordered map, which stores up to _N elements in place
+/// - find, insertion and erasure take expected constant time
+/// - elements are addressed by slot index and no pointers are stored, so a map of trivially copyable types
+///   can be copied as raw bytes, e.g. into shared memory
+/// - iteration visits the elements in slot order, which has nothing to do with insertion order
+/// The table uses open addressing with one control byte per slot, like SwissTable. A control byte is either EMPTY,
+/// DELETED or holds 7 bits of the hash of the key in its slot. Lookups probe aligned groups of 16 control bytes,
+/// compare all of them at once (SSE2) and only compare the keys of matching slots.
+/// There are at least 8 slots per 7 elements. Erased elements leave DELETED markers behind, unless their group
+/// still has an EMPTY slot. Once elements and markers fill 15/16 of the slots, the markers are cleaned up in place.
+/// A full map has to see SLOTS / 16 erasures between two cleanups, so their cost is constant per erasure.
+
+template <typename _Key, typename _Tp, size_t _N, typename _Hash = std::hash<_Key>,
+          typename _KeyEqual = std::equal_to<_Key>>
+class FixedHashMap {
+    static_assert(_N > 0, "FixedHashMap needs a capacity.");
+
+    /// Smallest power of two number of slots, which keeps the load at 7/8 with _N elements
+    static constexpr size_t table_size(size_t slots = detail::simd::group_width) {
+        return slots - slots / 8 >= _N ? slots : table_size(2 * slots);
+    }
+
+public:
+    // types:
+    typedef _Key key_type;
+    typedef _Tp mapped_type;
+    typedef std::pair<const _Key, _Tp> value_type;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef _Hash hasher;
+    typedef _KeyEqual key_equal;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+
+    enum : size_t {
+        MAX_SIZE = _N,       ///< Maximum size, defined at compile time
+        SLOTS = table_size() ///< Number of slots of the table
+    };
+
+private:
+    enum : int8_t { EMPTY = -128, DELETED = -2 };
+    enum : size_t {
+        WIDTH = detail::simd::group_width,
+        GROUPS = SLOTS / WIDTH,
+        MAX_LOAD = SLOTS - SLOTS / 16 ///< Elements and DELETED markers, which trigger a cleanup
+    };
+
+    template <bool _Const>
+    class SlotIterator {
+        friend FixedHashMap;
+        friend class SlotIterator<!_Const>;
+        typedef typename std::conditional<_Const, const FixedHashMap*, FixedHashMap*>::type map_pointer;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename FixedHashMap::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<_Const, const value_type*, value_type*>::type pointer;
+        typedef typename std::conditional<_Const, const value_type&, value_type&>::type reference;
+
+        SlotIterator(map_pointer map, size_type slot) : m_map(map), m_slot(slot) {
+        }
+        /// Mutable iterators convert to const ones
+        template <bool _Other, typename = typename std::enable_if<_Const && !_Other>::type>
+        SlotIterator(const SlotIterator<_Other>& other) : m_map(other.m_map), m_slot(other.m_slot) {
+        }
+
+        reference operator*() const CDT_CHECK_NOEXCEPT {
+            detail::check<std::out_of_range>(m_slot < SLOTS, "Iterator is out of range.");
+            return m_map->entries[m_slot].value;
+        }
+        pointer operator->() const CDT_CHECK_NOEXCEPT {
+            return &**this;
+        }
+        SlotIterator& operator++() noexcept {
+            m_slot = m_map->next_full(m_slot + 1);
+            return *this;
+        }
+        SlotIterator operator++(int) noexcept {
+            SlotIterator __tmp = *this;
+            ++*this;
+            return __tmp;
+        }
+        bool operator==(const SlotIterator& x) const noexcept {
+            return m_map == x.m_map && m_slot == x.m_slot;
+        }
+        bool operator!=(const SlotIterator& x) const noexcept {
+            return !(*this == x);
+        }
+
+    private:
+        map_pointer m_map;
+        size_type m_slot;
+    };
+
+public:
+    typedef SlotIterator<false> iterator;
+    typedef SlotIterator<true> const_iterator;
+
+    // construct/copy/destroy:
+    explicit FixedHashMap(const hasher& h = hasher(), const key_equal& eq = key_equal())
+            : n_elements(0), n_deleted(0), hash(h), equal(eq) {
+        std::memset(ctrl, EMPTY, SLOTS);
+    }
+    FixedHashMap(std::initializer_list<value_type> il) : FixedHashMap() {
+        this->insert(il);
+    }
+    // Copies keep the slots of other, so no key is hashed again
+    FixedHashMap(const FixedHashMap& other) : n_elements(0), n_deleted(0), hash(other.hash), equal(other.equal) {
+        take_slots(other);
+    }
+    FixedHashMap(FixedHashMap&& other) : n_elements(0), n_deleted(0), hash(other.hash), equal(other.equal) {
+        take_slots(other);
+        other.clear();
+    }
+    FixedHashMap& operator=(const FixedHashMap& other) {
+        if (this != &other) {
+            this->clear();
+            hash = other.hash;
+            equal = other.equal;
+            take_slots(other);
+        }
+        return *this;
+    }
+    FixedHashMap& operator=(FixedHashMap&& other) {
+        if (this != &other) {
+            this->clear();
+            hash = other.hash;
+            equal = other.equal;
+            take_slots(other);
+            other.clear();
+        }
+        return *this;
+    }
+    ~FixedHashMap() {
+        destroy_entries();
+    }
+
+    // iterators:
+    iterator begin() noexcept {
+        return iterator(this, next_full(0));
+    }
+    iterator end() noexcept {
+        return iterator(this, SLOTS);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(this, next_full(0));
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(this, SLOTS);
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    // capacity:
+    size_type size() const noexcept {
+        return n_elements;
+    }
+    size_type capacity() const noexcept {
+        return MAX_SIZE;
+    }
+    bool empty() const noexcept {
+        return n_elements == 0;
+    }
+    /// Number of slots of the table, which is the bound of iteration
+    size_type slot_count() const noexcept {
+        return SLOTS;
+    }
+    hasher hash_function() const {
+        return hash;
+    }
+    key_equal key_eq() const {
+        return equal;
+    }
+
+    // lookup:
+    iterator find(const key_type& key) {
+        return iterator(this, find_slot(key, hash_of(key)));
+    }
+    const_iterator find(const key_type& key) const {
+        return const_iterator(this, find_slot(key, hash_of(key)));
+    }
+    bool contains(const key_type& key) const {
+        return find_slot(key, hash_of(key)) != SLOTS;
+    }
+    size_type count(const key_type& key) const {
+        return contains(key);
+    }
+    /// Access the value of key, always throws std::out_of_range if it is missing
+    mapped_type& at(const key_type& key) {
+        const size_type i = find_slot(key, hash_of(key));
+        detail::require<std::out_of_range>(i != SLOTS, "Key is not in FixedHashMap.");
+        return entries[i].value.second;
+    }
+    const mapped_type& at(const key_type& key) const {
+        const size_type i = find_slot(key, hash_of(key));
+        detail::require<std::out_of_range>(i != SLOTS, "Key is not in FixedHashMap.");
+        return entries[i].value.second;
+    }
+    /// Access the value of key, which is value initialized if key is missing
+    mapped_type& operator[](const key_type& key) {
+        return this->try_emplace(key).first->second;
+    }
+    mapped_type& operator[](key_type&& key) {
+        return this->try_emplace(std::move(key)).first->second;
+    }
+
+    // modifiers:
+    /// Insert x, unless its key is present already. Returns the element of the key and whether x was inserted.
+    /// Inserting a new key into a full map throws std::length_error, checked according to CDT_CHECK_POLICY.
+    std::pair<iterator, bool> insert(const value_type& x) {
+        return emplace_key(x.first, x);
+    }
+    std::pair<iterator, bool> insert(value_type&& x) {
+        return emplace_key(x.first, std::move(x));
+    }
+    template <class _InputIterator>
+    void insert(_InputIterator first, _InputIterator last) {
+        for (; first != last; ++first) {
+            this->insert(*first);
+        }
+    }
+    void insert(std::initializer_list<value_type> il) {
+        this->insert(il.begin(), il.end());
+    }
+    /// Construct an element from __args, unless its key is present already. The element is constructed up front.
+    template <typename... _Args>
+    std::pair<iterator, bool> emplace(_Args&&... __args) {
+        return this->insert(value_type(std::forward<_Args>(__args)...));
+    }
+    /// Construct the value of key from __args, only if key is missing
+    template <typename... _Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, _Args&&... __args) {
+        return emplace_key(key, std::piecewise_construct, std::forward_as_tuple(key),
+                           std::forward_as_tuple(std::forward<_Args>(__args)...));
+    }
+    template <typename... _Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, _Args&&... __args) {
+        return emplace_key(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                           std::forward_as_tuple(std::forward<_Args>(__args)...));
+    }
+    /// Assign obj to the value of key, inserts key if it is missing
+    template <typename _M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, _M&& obj) {
+        std::pair<iterator, bool> result = this->try_emplace(key, std::forward<_M>(obj));
+        if (!result.second) {
+            result.first->second = std::forward<_M>(obj);
+        }
+        return result;
+    }
+
+    /// Erase the element of key, returns the number of erased elements
+    size_type erase(const key_type& key) {
+        const size_type i = find_slot(key, hash_of(key));
+        if (i == SLOTS) {
+            return 0;
+        }
+        erase_slot(i);
+        return 1;
+    }
+    /// Erase the element at position, returns an iterator to the next element
+    iterator erase(const_iterator position) {
+        detail::check<std::out_of_range>(position.m_slot < SLOTS, "Iterator points past valid data. Can not erase.");
+        erase_slot(position.m_slot);
+        return iterator(this, next_full(position.m_slot + 1));
+    }
+    void clear() {
+        destroy_entries();
+        std::memset(ctrl, EMPTY, SLOTS);
+        n_elements = 0;
+        n_deleted = 0;
+    }
+
+private:
+    /// Spread the bits of a hash, the low 7 bits go into the control byte, the others select the first group
+    size_t hash_of(const key_type& key) const {
+        const uint64_t x = static_cast<uint64_t>(hash(key)) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(x ^ (x >> 32));
+    }
+    static int8_t control_of(size_t h) {
+        return static_cast<int8_t>(h & 0x7f);
+    }
+
+    /// Groups are probed in triangular steps, which visits every group once, as their number is a power of two.
+    /// Lookups end at the first group with an EMPTY slot, which there always is.
+    /// Only keys of slots with a matching control byte are read, which GCC can not tell apart from unused slots.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    size_type find_slot(const key_type& key, size_t h) const {
+        const int8_t control = control_of(h);
+        size_type g = (h >> 7) & (GROUPS - 1);
+        for (size_type step = 1;; ++step) {
+            const int8_t* group = ctrl + g * WIDTH;
+            for (unsigned match = detail::simd::match_byte(group, control); match != 0; match &= match - 1) {
+                const size_type i = g * WIDTH + detail::count_trailing_zeros(match);
+                if (equal(entries[i].value.first, key)) {
+                    return i;
+                }
+            }
+            if (detail::simd::match_byte(group, EMPTY) != 0) {
+                return SLOTS;
+            }
+            g = (g + step) & (GROUPS - 1);
+        }
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+    /// First EMPTY or DELETED slot on the probe sequence of h
+    size_type free_slot(size_t h) const {
+        size_type g = (h >> 7) & (GROUPS - 1);
+        for (size_type step = 1;; ++step) {
+            const unsigned free = detail::simd::match_negative(ctrl + g * WIDTH);
+            if (free != 0) {
+                return g * WIDTH + detail::count_trailing_zeros(free);
+            }
+            g = (g + step) & (GROUPS - 1);
+        }
+    }
+    /// First slot from i on, which holds an element, SLOTS if there is none
+    size_type next_full(size_type i) const noexcept {
+        while (i < SLOTS) {
+            const size_type g = i / WIDTH;
+            const unsigned full = ~detail::simd::match_negative(ctrl + g * WIDTH) & (0xffffu << (i % WIDTH)) & 0xffffu;
+            if (full != 0) {
+                return g * WIDTH + detail::count_trailing_zeros(full);
+            }
+            i = (g + 1) * WIDTH;
+        }
+        return SLOTS;
+    }
+
+    /// Find key and construct its element from __args if it is missing
+    template <typename... _Args>
+    std::pair<iterator, bool> emplace_key(const key_type& key, _Args&&... __args) {
+        const size_t h = hash_of(key);
+        size_type i = find_slot(key, h);
+        if (i != SLOTS) {
+            return std::make_pair(iterator(this, i), false);
+        }
+        detail::check<std::length_error>(n_elements < _N, "No space left in FixedHashMap.");
+        i = free_slot(h);
+        if (ctrl[i] == EMPTY && n_elements + n_deleted >= MAX_LOAD) {
+            drop_deleted();
+            i = free_slot(h);
+        }
+        entries[i].construct(std::forward<_Args>(__args)...);
+        n_deleted -= ctrl[i] == DELETED;
+        ctrl[i] = control_of(h);
+        ++n_elements;
+        return std::make_pair(iterator(this, i), true);
+    }
+
+    /// A slot may only become EMPTY, if its group has an EMPTY slot already, since no lookup passes such a group
+    void erase_slot(size_type i) {
+        entries[i].destroy();
+        if (detail::simd::match_byte(ctrl + i / WIDTH * WIDTH, EMPTY) != 0) {
+            ctrl[i] = EMPTY;
+        } else {
+            ctrl[i] = DELETED;
+            ++n_deleted;
+        }
+        --n_elements;
+    }
+
+    /// Remove all DELETED markers in place. Each element moves to the first free slot of its probe sequence,
+    /// unless that is in its own group. Elements, which still have to be placed, are marked DELETED meanwhile.
+    void drop_deleted() {
+        for (size_type i = 0; i < SLOTS; i++) {
+            if (ctrl[i] == DELETED) {
+                ctrl[i] = EMPTY;
+            } else if (ctrl[i] >= 0) {
+                ctrl[i] = DELETED;
+            }
+        }
+        for (size_type i = 0; i < SLOTS;) {
+            if (ctrl[i] != DELETED) {
+                ++i;
+                continue;
+            }
+            const size_t h = hash_of(entries[i].value.first);
+            const size_type target = free_slot(h);
+            if (target / WIDTH == i / WIDTH) {
+                ctrl[i] = control_of(h);
+                ++i;
+            } else if (ctrl[target] == EMPTY) {
+                entries[target].construct(std::move(entries[i].value));
+                entries[i].destroy();
+                ctrl[target] = control_of(h);
+                ctrl[i] = EMPTY;
+                ++i;
+            } else {
+                // The target holds an element, which is not placed yet. It takes slot i and is placed next.
+                value_type tmp(std::move(entries[target].value));
+                entries[target].destroy();
+                entries[target].construct(std::move(entries[i].value));
+                entries[i].destroy();
+                entries[i].construct(std::move(tmp));
+                ctrl[target] = control_of(h);
+            }
+        }
+        n_deleted = 0;
+    }
+
+    /// Take over the slots of this empty map from other.
+    /// Trivially copyable elements are copied as raw bytes, others are copied from a const map and moved otherwise.
+    template <typename _Map>
+    void take_slots(_Map& other) {
+        typedef typename std::conditional<std::is_const<_Map>::value, const value_type&, value_type&&>::type source;
+        std::memcpy(ctrl, other.ctrl, SLOTS);
+        if (std::is_trivially_copyable<value_type>::value) {
+            std::memcpy(static_cast<void*>(entries), other.entries, sizeof(entries));
+        } else {
+            size_type i = next_full(0);
+            try {
+                for (; i < SLOTS; i = next_full(i + 1)) {
+                    entries[i].construct(static_cast<source>(other.entries[i].value));
+                }
+            } catch (...) {
+                for (size_type k = next_full(0); k < i; k = next_full(k + 1)) {
+                    entries[k].destroy();
+                }
+                std::memset(ctrl, EMPTY, SLOTS);
+                throw;
+            }
+        }
+        n_elements = other.n_elements;
+        n_deleted = other.n_deleted;
+    }
+
+    void destroy_entries() {
+        if (!std::is_trivially_destructible<value_type>::value) {
+            for (size_type i = next_full(0); i < SLOTS; i = next_full(i + 1)) {
+                entries[i].destroy();
+            }
+        }
+    }
+
+    alignas(WIDTH) int8_t ctrl[SLOTS]; ///< Control byte of each slot
+    detail::UninitializedStorage<value_type> entries[SLOTS];
+    size_type n_elements;
+    size_type n_deleted; ///< Number of DELETED markers
+    hasher hash;
+    key_equal equal;
+};
+} // Namespace cdt
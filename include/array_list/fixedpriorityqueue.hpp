@@ -0,0 +1,271 @@
+#pragma once
+#include <algorithm>
+#include <array_list/detail/check_policy.hpp>
+#include <array_list/detail/slot_table.hpp>
+#include <array_list/fixedvector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+namespace cdt {
+
+/// \brief A priority queue, which hands out stable handles to its elements
+/// - access to the element of highest priority takes constant time
+/// - insertion, removal and changing the value of any element by handle take O(log n)
+/// - handles of removed elements are detected as stale
+/// Like std::priority_queue, the top is the largest element according to _Compare, std::greater gives a min queue.
+/// The elements form a 4-ary heap in a FixedVector: a node and its siblings share a cache line for small _Tp,
+/// and the heap is only half as deep as a binary one. Handles hold index and generation of a slot like in SlotMap,
+/// and each slot tracks the heap position of its element, see detail::SlotTable.
+/// Elements are moved along their path through the heap, _Compare and the moves of _Tp must not throw.
+
+template <typename _Tp, size_t _N, typename _Compare = std::less<_Tp>>
+class FixedPriorityQueue {
+    typedef detail::SlotTable<_N, FixedPriorityQueue> table_type;
+
+public:
+    // types:
+    typedef FixedPriorityQueue<_Tp, _N, _Compare> list_type;
+    typedef _Tp value_type;
+    typedef _Compare value_compare;
+    typedef size_t size_type;
+    typedef typename table_type::position_type position_type;
+    typedef typename table_type::generation_type generation_type;
+    typedef const _Tp* const_pointer;
+    typedef const _Tp& const_reference;
+    typedef typename FixedVector<_Tp, _N>::const_iterator const_iterator;
+
+    /// Stable reference to an element. A default constructed handle refers to no element.
+    typedef typename table_type::Handle Handle;
+
+    enum {
+        MAX_SIZE = _N, /// Maximum size, defined at compile time
+        ARITY = 4      /// Children per heap node
+    };
+
+public:
+    // construct/copy/destroy:
+    explicit FixedPriorityQueue(const _Compare& compare = _Compare()) : comp(compare) {}
+    FixedPriorityQueue(const FixedPriorityQueue& other) : values(other.values), comp(other.comp) {
+        table.copy_from(other.table, values.size());
+    }
+    // The count is taken from values once it holds the elements, other.values may already be moved from.
+    // other releases its slots instead of forgetting them, so its old handles stay stale once it is refilled.
+    FixedPriorityQueue(FixedPriorityQueue&& other) : values(std::move(other.values)), comp(other.comp) {
+        table.copy_from(other.table, values.size());
+        other.table.release_all(values.size());
+    }
+    FixedPriorityQueue& operator=(const FixedPriorityQueue& other) {
+        if (this != &other) {
+            values = other.values;
+            comp = other.comp;
+            table.copy_from(other.table, values.size());
+        }
+        return *this;
+    }
+    FixedPriorityQueue& operator=(FixedPriorityQueue&& other) {
+        if (this != &other) {
+            values = std::move(other.values);
+            comp = other.comp;
+            table.copy_from(other.table, values.size());
+            other.table.release_all(values.size());
+        }
+        return *this;
+    }
+
+    size_type size() const noexcept {
+        return values.size();
+    };
+    size_type capacity() const noexcept {
+        return MAX_SIZE;
+    };
+    bool empty() const noexcept {
+        return values.empty();
+    };
+    value_compare value_comp() const {
+        return comp;
+    }
+
+    /// Iterators visit the elements in heap order, the top first. Elements can only be changed through a handle.
+    const_iterator begin() const noexcept {
+        return values.begin();
+    };
+    const_iterator end() const noexcept {
+        return values.end();
+    };
+
+    /// Element of highest priority, checked according to CDT_CHECK_POLICY
+    const_reference top() const CDT_CHECK_NOEXCEPT {
+        detail::check<std::out_of_range>(!empty(), "FixedPriorityQueue is empty.");
+        return values.begin()[0];
+    }
+    /// Handle of the element of highest priority, checked according to CDT_CHECK_POLICY
+    Handle top_handle() const CDT_CHECK_NOEXCEPT {
+        detail::check<std::out_of_range>(!empty(), "FixedPriorityQueue is empty.");
+        return table.handle_at(0);
+    }
+
+    /// Copy element into queue
+    Handle push(const value_type& x) {
+        return this->emplace(x);
+    }
+    /// Move element into queue
+    Handle push(value_type&& x) {
+        return this->emplace(std::move(x));
+    }
+    /// Create new object in queue and return its handle
+    template <typename... _Args>
+    Handle emplace(_Args&&... __args) {
+        detail::check<std::length_error>(size() < capacity(), "No space left in FixedPriorityQueue.");
+        values.emplace_back(std::forward<_Args>(__args)...);
+        const position_type i = table.acquire();
+        table.place(values.size() - 1, i);
+        sift_up(values.size() - 1);
+        return table.handle(i);
+    }
+
+    /// Erase the element of highest priority, checked according to CDT_CHECK_POLICY
+    void pop() {
+        detail::check<std::out_of_range>(!empty(), "FixedPriorityQueue is empty.");
+        erase_at(0);
+    }
+    /// Erase the element of handle, false if the handle is stale
+    bool erase(Handle handle) {
+        if (!contains(handle)) {
+            return false;
+        }
+        erase_at(table.position(handle));
+        return true;
+    }
+
+    /// Replace the element of handle by x, which may raise or lower its priority
+    void update(Handle handle, const value_type& x) {
+        reference_of(handle) = x;
+        restore(table.position(handle));
+    }
+    void update(Handle handle, value_type&& x) {
+        reference_of(handle) = std::move(x);
+        restore(table.position(handle));
+    }
+    /// Replace the element of handle by x, which must not have a lower priority, e.g. an earlier deadline in a
+    /// min queue. The element only moves towards the top, so this is cheaper than update().
+    /// A lower priority is reported as std::invalid_argument according to CDT_CHECK_POLICY.
+    void decrease_key(Handle handle, const value_type& x) {
+        value_type& y = reference_of(handle);
+        detail::check<std::invalid_argument>(!comp(x, y), "Value would lower the priority.");
+        y = x;
+        sift_up(table.position(handle));
+    }
+    void decrease_key(Handle handle, value_type&& x) {
+        value_type& y = reference_of(handle);
+        detail::check<std::invalid_argument>(!comp(x, y), "Value would lower the priority.");
+        y = std::move(x);
+        sift_up(table.position(handle));
+    }
+
+    /// Whether handle refers to an element in the queue, stale and default constructed handles do not
+    bool contains(Handle handle) const noexcept {
+        return table.contains(handle);
+    }
+    /// Pointer to the element of handle, nullptr if the handle is stale
+    const_pointer find(Handle handle) const noexcept {
+        return contains(handle) ? values.begin() + table.position(handle) : nullptr;
+    }
+    /// Access the element of handle, checked according to CDT_CHECK_POLICY
+    const_reference operator[](Handle handle) const CDT_CHECK_NOEXCEPT {
+        detail::check<std::out_of_range>(contains(handle), "Handle is stale.");
+        return values.begin()[table.position(handle)];
+    }
+    /// Access the element of handle, always throws on a stale handle
+    const_reference at(Handle handle) const {
+        detail::require<std::out_of_range>(contains(handle), "Handle is stale.");
+        return values.begin()[table.position(handle)];
+    }
+
+    /// Handle of the element it points to
+    Handle handle_of(const_iterator it) const noexcept {
+        return table.handle_at(static_cast<size_type>(it - values.begin()));
+    }
+
+    /// Erase all elements, all handles become stale
+    void clear() {
+        table.release_all(values.size());
+        values.clear();
+    }
+
+private:
+    value_type& reference_of(Handle handle) {
+        detail::check<std::out_of_range>(contains(handle), "Handle is stale.");
+        return values.begin()[table.position(handle)];
+    }
+    /// Move the element at k towards the top, while it has a higher priority than its parent
+    void sift_up(size_type k) {
+        value_type* v = values.begin();
+        if (k == 0 || !comp(v[(k - 1) / ARITY], v[k])) {
+            return;
+        }
+        value_type x = std::move(v[k]);
+        const position_type i = table.owner(k);
+        do {
+            const size_type parent = (k - 1) / ARITY;
+            if (!comp(v[parent], x)) {
+                break;
+            }
+            v[k] = std::move(v[parent]);
+            table.place(k, table.owner(parent));
+            k = parent;
+        } while (k > 0);
+        v[k] = std::move(x);
+        table.place(k, i);
+    }
+    /// Move the element at k towards the bottom, while one of its children has a higher priority
+    void sift_down(size_type k) {
+        value_type* v = values.begin();
+        const size_type n = values.size();
+        value_type x = std::move(v[k]);
+        const position_type i = table.owner(k);
+        for (size_type first = ARITY * k + 1; first < n; first = ARITY * k + 1) {
+            const size_type last = std::min<size_type>(first + ARITY, n);
+            size_type child = first;
+            for (size_type c = first + 1; c < last; c++) {
+                if (comp(v[child], v[c])) {
+                    child = c;
+                }
+            }
+            if (!comp(x, v[child])) {
+                break;
+            }
+            v[k] = std::move(v[child]);
+            table.place(k, table.owner(child));
+            k = child;
+        }
+        v[k] = std::move(x);
+        table.place(k, i);
+    }
+    /// Move the element at k to its place after its value changed
+    void restore(size_type k) {
+        const value_type* v = values.begin();
+        if (k > 0 && comp(v[(k - 1) / ARITY], v[k])) {
+            sift_up(k);
+        } else {
+            sift_down(k);
+        }
+    }
+    /// Erase the element at heap position k, the last element takes its place and is moved from there
+    void erase_at(size_type k) {
+        table.release(table.owner(k));
+        const size_type last = values.size() - 1;
+        values.erase(values.begin() + k);
+        if (k != last) {
+            table.place(k, table.owner(last));
+            restore(k);
+        }
+    }
+
+    FixedVector<_Tp, _N> values; ///< Elements in heap order
+    table_type table;
+    _Compare comp;
+};
+} // Namespace cdt
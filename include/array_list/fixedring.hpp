@@ -0,0 +1,183 @@
+#pragma once
+#include <array_list/detail/constexpr.hpp>
+#include <array_list/detail/index_type.hpp>
+#include <array_list/detail/uninitialized.hpp>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace cdt {
+
+/// \brief A first in, first out ring buffer for exactly one producer and one consumer thread
+/// - push and pop are wait-free
+/// - preserves order
+/// - elements are only constructed while they are part of the container
+/// try_push()/push_n() may only be called by the producer, try_pop()/pop_n() only by the consumer.
+
+template <typename _Tp, size_t _N>
+class FixedRing {
+public:
+    // types:
+    typedef FixedRing<_Tp, _N> list_type;
+    typedef _Tp value_type;
+    typedef size_t size_type;
+    typedef typename detail::MinimalIndex<2 * _N>::type position_type;
+    typedef _Tp* pointer;
+    typedef _Tp& reference;
+    typedef const _Tp& const_reference;
+
+    enum {
+        MAX_SIZE = _N /// Maximum size, defined at compile time
+    };
+
+    static_assert(_N > 0, "FixedRing needs a capacity of at least one element.");
+
+public:
+    // construct/copy/destroy:
+    FixedRing() : head(0), tail_cache(0), tail(0), head_cache(0){};
+    FixedRing(const FixedRing&) = delete;
+    FixedRing& operator=(const FixedRing&) = delete;
+    ~FixedRing() {
+        if (!std::is_trivially_destructible<value_type>::value) {
+            for (position_type i = head.load(std::memory_order_relaxed); i != tail.load(std::memory_order_relaxed);
+                 i = increment(i)) {
+                elements()[slot(i)].~value_type();
+            }
+        }
+    }
+
+    /// Number of elements, only a snapshot if called while the other side is active
+    size_type size() const {
+        return distance(head.load(std::memory_order_acquire), tail.load(std::memory_order_acquire));
+    };
+    size_type capacity() const {
+        return MAX_SIZE;
+    };
+    bool empty() const {
+        return size() == 0;
+    };
+
+    // producer:
+    /// Copy element into container, false if it is full
+    bool try_push(const value_type& x) {
+        return this->try_emplace(x);
+    }
+    /// Move element into container, false if it is full
+    bool try_push(value_type&& x) {
+        return this->try_emplace(std::move(x));
+    }
+    /// Create new object in container, false if it is full
+    template <typename... _Args>
+    bool try_emplace(_Args&&... __args) {
+        const position_type t = tail.load(std::memory_order_relaxed);
+        if (distance(head_cache, t) == _N) {
+            head_cache = head.load(std::memory_order_acquire);
+            if (distance(head_cache, t) == _N) {
+                return false;
+            }
+        }
+        detail::construct_at(elements() + slot(t), std::forward<_Args>(__args)...);
+        tail.store(increment(t), std::memory_order_release);
+        return true;
+    }
+    /// Copy up to n elements starting at first into the container, returns the number of elements pushed.
+    /// All elements are published at once. If a copy throws, the elements copied before are published.
+    template <class _InputIterator>
+    size_type push_n(_InputIterator first, size_type n) {
+        const position_type t = tail.load(std::memory_order_relaxed);
+        size_type space = _N - distance(head_cache, t);
+        if (space < n) {
+            head_cache = head.load(std::memory_order_acquire);
+            space = _N - distance(head_cache, t);
+        }
+        const size_type count = n < space ? n : space;
+        position_type i = t;
+        try {
+            for (size_type k = 0; k < count; ++k, ++first) {
+                detail::construct_at(elements() + slot(i), *first);
+                i = increment(i);
+            }
+        } catch (...) {
+            tail.store(i, std::memory_order_release);
+            throw;
+        }
+        tail.store(i, std::memory_order_release);
+        return count;
+    }
+
+    // consumer:
+    /// Move the oldest element out of the container, false if it is empty
+    bool try_pop(value_type& x) {
+        const position_type h = head.load(std::memory_order_relaxed);
+        if (h == tail_cache) {
+            tail_cache = tail.load(std::memory_order_acquire);
+            if (h == tail_cache) {
+                return false;
+            }
+        }
+        pointer element = elements() + slot(h);
+        x = std::move(*element);
+        element->~value_type();
+        head.store(increment(h), std::memory_order_release);
+        return true;
+    }
+    /// Move up to n of the oldest elements to out, returns the number of elements popped.
+    /// All slots are released at once. If writing to out throws, the elements written before are released,
+    /// the others stay in the container.
+    template <class _OutputIterator>
+    size_type pop_n(_OutputIterator out, size_type n) {
+        const position_type h = head.load(std::memory_order_relaxed);
+        size_type available = distance(h, tail_cache);
+        if (available < n) {
+            tail_cache = tail.load(std::memory_order_acquire);
+            available = distance(h, tail_cache);
+        }
+        const size_type count = n < available ? n : available;
+        position_type i = h;
+        try {
+            for (size_type k = 0; k < count; ++k, ++out) {
+                pointer element = elements() + slot(i);
+                *out = std::move(*element);
+                element->~value_type();
+                i = increment(i);
+            }
+        } catch (...) {
+            head.store(i, std::memory_order_release);
+            throw;
+        }
+        head.store(i, std::memory_order_release);
+        return count;
+    }
+
+private:
+    // Positions run from 0 to 2 * _N - 1, which tells a full from an empty ring without wasting a slot.
+    static position_type increment(position_type i) {
+        return i + 1 == 2 * _N ? 0 : i + 1;
+    }
+    static size_type slot(position_type i) {
+        return i < _N ? i : i - _N;
+    }
+    static size_type distance(position_type from, position_type to) {
+        return to >= from ? to - from : 2 * _N - from + to;
+    }
+
+    pointer elements() {
+        return data.ptr();
+    }
+
+    static constexpr size_t cache_line = 64;
+
+    // Consumer side
+    alignas(cache_line) std::atomic<position_type> head; ///< Position of the oldest element
+    position_type tail_cache;                            ///< Last tail seen by the consumer
+    // Producer side
+    alignas(cache_line) std::atomic<position_type> tail; ///< Position one past the newest element
+    position_type head_cache;                            ///< Last head seen by the producer
+
+    alignas(cache_line) detail::UninitializedArray<_Tp, _N> data;
+};
+
+template <typename _Tp, size_t _N>
+constexpr size_t FixedRing<_Tp, _N>::cache_line;
+} // Namespace cdt
@@ -1,18 +1,64 @@
 #pragma once
-#include <bitset>
+#include <array_list/detail/check_policy.hpp>
+#include <array_list/detail/constexpr.hpp>
+#include <array_list/detail/index_type.hpp>
+#include <array_list/detail/snapshot.hpp>
+#include <array_list/detail/stats.hpp>
+#include <array_list/detail/uninitialized.hpp>
+#include <array_list/detail/vector_algorithms.hpp>
 #include <cassert>
+#include <cstring>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace cdt {
 
+namespace detail {
+/// \brief Storage of a FixedVector.
+/// Destroys the remaining elements on destruction. For trivially destructible types this is omitted,
+/// which leaves the whole container trivially destructible.
+template <typename _Tp, size_t _N, bool = std::is_trivially_destructible<_Tp>::value>
+struct FixedVectorStorage {
+    CDT_CONSTEXPR FixedVectorStorage() : _end_index(0){};
+    CDT_CONSTEXPR ~FixedVectorStorage() {
+        for (size_t i = 0; i < _end_index; i++) {
+            data.ptr()[i].~_Tp();
+        }
+    }
+
+    UninitializedArray<_Tp, _N> data;
+    typename MinimalIndex<_N>::type _end_index; ///< Narrowest type able to hold the size
+};
+
+template <typename _Tp, size_t _N>
+struct FixedVectorStorage<_Tp, _N, true> {
+    CDT_CONSTEXPR FixedVectorStorage() : _end_index(0){};
+
+    UninitializedArray<_Tp, _N> data;
+    typename MinimalIndex<_N>::type _end_index; ///< Narrowest type able to hold the size
+};
+} // namespace detail
+
 /// \brief An array like container
 /// - supports insertion only at the end
 /// - allows deletion anywhere
 /// - does not guarantee order
 /// - allows random access
+/// Elements are only constructed while they are part of the container.
+/// Search and removal by value are shared with SmallVector, see detail::VectorAlgorithms.
+/// Records its usage, if CDT_ENABLE_STATS is set.
 
 template <typename _Tp, size_t _N>
-class FixedVector {
+class FixedVector : private detail::FixedVectorStorage<_Tp, _N>,
+                    private detail::UsageRecorder,
+                    public detail::VectorAlgorithms<FixedVector<_Tp, _N>, _Tp> {
+    typedef detail::FixedVectorStorage<_Tp, _N> storage_type;
+    typedef detail::VectorAlgorithms<FixedVector<_Tp, _N>, _Tp> algorithms_type;
+    friend algorithms_type;
+    using storage_type::_end_index;
+    using algorithms_type::assert_valid;
+
 public:
     // types:
     typedef FixedVector<_Tp, _N> list_type;
@@ -22,7 +68,7 @@ public:
     typedef size_t difference_type;
     typedef _Tp* pointer;
     typedef _Tp& reference;
-    typedef const reference const_reference;
+    typedef const _Tp& const_reference;
     typedef _Tp* iterator;
     typedef const _Tp* const_iterator;
 
@@ -32,123 +78,274 @@ public:
 
 public:
     // construct/copy/destroy:
-    FixedVector() : _end_index(0){};
+    CDT_CONSTEXPR FixedVector(){};
+    CDT_CONSTEXPR FixedVector(const FixedVector& other) : storage_type(), detail::UsageRecorder() {
+        copy_from(other, std::is_trivially_copyable<value_type>());
+    }
+    // Moves only throw, if moving an element does, so std::vector moves FixedVectors on reallocation
+    CDT_CONSTEXPR FixedVector(FixedVector&& other) noexcept(std::is_nothrow_move_constructible<_Tp>::value) {
+        move_from(other, std::is_trivially_copyable<value_type>());
+    }
+    CDT_CONSTEXPR FixedVector& operator=(const FixedVector& other) {
+        if (this != &other) {
+            this->clear();
+            copy_from(other, std::is_trivially_copyable<value_type>());
+        }
+        return *this;
+    }
+    CDT_CONSTEXPR FixedVector& operator=(FixedVector&& other) noexcept(std::is_nothrow_move_constructible<_Tp>::value) {
+        if (this != &other) {
+            this->clear();
+            move_from(other, std::is_trivially_copyable<value_type>());
+        }
+        return *this;
+    }
 
-    size_type size() const {
+    CDT_CONSTEXPR size_type size() const noexcept {
         return _end_index;
     };
-    size_type capacity() const {
+    CDT_CONSTEXPR size_type capacity() const noexcept {
         return MAX_SIZE;
     };
-    bool empty() const {
+    CDT_CONSTEXPR bool empty() const noexcept {
         return _end_index == 0;
     };
 
+    /// Usage recorded since construction or the last reset_stats(), all zero unless CDT_ENABLE_STATS is set
+    UsageStats stats() const noexcept {
+        return this->usage();
+    }
+    void reset_stats() noexcept {
+        this->reset_usage(size());
+    }
+
     /// Iterator element access:
-    iterator begin() {
-        return &data[0];
+    CDT_CONSTEXPR iterator begin() noexcept {
+        return elements();
     };
-    iterator end() {
-        return &data[_end_index];
+    CDT_CONSTEXPR iterator end() noexcept {
+        return elements() + _end_index;
+    };
+    CDT_CONSTEXPR const_iterator begin() const noexcept {
+        return elements();
+    };
+    CDT_CONSTEXPR const_iterator end() const noexcept {
+        return elements() + _end_index;
     };
 
     /// Reference element access:
-    reference front() {
+    CDT_CONSTEXPR reference front() noexcept {
         return *begin();
     }
-    const_reference front() const {
+    CDT_CONSTEXPR const_reference front() const noexcept {
         return *begin();
     }
-    reference back() {
-        return data[_end_index - 1];
+    CDT_CONSTEXPR reference back() noexcept {
+        return elements()[_end_index - 1];
     }
-    const_reference back() const {
-        return data[_end_index - 1];
+    CDT_CONSTEXPR const_reference back() const noexcept {
+        return elements()[_end_index - 1];
     }
 
-    /// Access container elements by subscript
-    reference operator[](std::size_t idx) {
+    /// Access container elements by subscript, checked according to CDT_CHECK_POLICY
+    CDT_CONSTEXPR reference operator[](std::size_t idx) CDT_CHECK_NOEXCEPT {
         assert_valid(idx);
-        return data[idx];
+        return elements()[idx];
     }
-    const_reference operator[](std::size_t idx) const {
+    CDT_CONSTEXPR const_reference operator[](std::size_t idx) const CDT_CHECK_NOEXCEPT {
         assert_valid(idx);
-        return data[idx];
+        return elements()[idx];
+    }
+    /// Access container elements by subscript, always throws on an invalid idx
+    CDT_CONSTEXPR reference at(std::size_t idx) {
+        detail::require<std::out_of_range>(idx < _end_index, "Out of range error.");
+        return elements()[idx];
+    }
+    CDT_CONSTEXPR const_reference at(std::size_t idx) const {
+        detail::require<std::out_of_range>(idx < _end_index, "Out of range error.");
+        return elements()[idx];
     }
 
     /// Copy element into container
-    void push_back(const value_type& x) {
-        assert_capacity();
-        data[_end_index++] = x;
+    CDT_CONSTEXPR void push_back(const value_type& x) {
+        this->emplace_back(x);
     }
 
     /// Move element into container
-    void push_back(value_type&& x) {
-        assert_capacity();
-        data[_end_index++] = std::move(x);
+    CDT_CONSTEXPR void push_back(value_type&& x) {
+        this->emplace_back(std::move(x));
     }
 
     /// Create new object in container
-    // template <typename... _Args>
-    // void emplace_back(_Args&&... __args) {
-    // assert_valid(_end_index);
-    //     data[_end_index++] = (std::forward<_Args>(__args)...);
-    // }
+    template <typename... _Args>
+    CDT_CONSTEXPR reference emplace_back(_Args&&... __args) {
+        this->record_overflow(size(), 1, capacity());
+        assert_capacity();
+        detail::construct_at(end(), std::forward<_Args>(__args)...);
+        this->record_insert(size() + 1);
+        return elements()[_end_index++];
+    }
 
     /// Erase last element
-    void pop_back() {
+    CDT_CONSTEXPR void pop_back() {
         this->erase(_end_index - 1); // end points one past the last element, so decrement it first.
     }
 
     /// Erase first element
-    void pop_front() {
+    CDT_CONSTEXPR void pop_front() {
         this->erase(begin());
     }
 
     /// Erase arbitrary element
-    void erase(position_type position) {
-        this->erase(&data[position]);
+    CDT_CONSTEXPR void erase(position_type position) {
+        this->erase(elements() + position);
     }
     /// Erase arbitrary element
-    void erase(iterator position) {
+    CDT_CONSTEXPR void erase(iterator position) {
         /// Assert iterator is within range
         assert_valid(position);
 
-        /// Copy last element to this position to guarantee gapless memory usage
-        *position = std::move(data[_end_index - 1]);
+        /// Move last element to this position to guarantee gapless memory usage
+        iterator last = end() - 1;
+        if (position != last) {
+            *position = std::move(*last);
+        }
+        last->~value_type();
 
         /// Adjust end index
         --_end_index;
+        this->record_erase();
     }
 
     /// Erase all elements from vector.
-    void clear() {
+    CDT_CONSTEXPR void clear() {
+        if (!std::is_trivially_destructible<value_type>::value) {
+            for (iterator it = begin(); it != end(); ++it) {
+                it->~value_type();
+            }
+        }
+        this->record_erase(size());
         _end_index = 0;
     };
 
-private:
-    /// Check whether iterator is within bounds
-    void assert_valid(const_iterator it) {
-        if (it < &data[0] || it >= &data[_end_index]) {
-            throw std::out_of_range("Out of range error.");
+    // snapshots, only available for trivially copyable value_type:
+    /// Bytes needed by snapshot()
+    size_type snapshot_size() const noexcept {
+        return image_offset() + size() * sizeof(value_type);
+    }
+    /// Copy a header and the elements into buffer, returns the number of written bytes.
+    /// Throws std::length_error if bytes is less than snapshot_size().
+    size_type snapshot(void* buffer, size_type bytes) const {
+        static_assert(std::is_trivially_copyable<value_type>::value, "Snapshots need trivially copyable elements.");
+        SnapshotHeader header = snapshot_header();
+        header.size = size();
+        return detail::write_snapshot(buffer, bytes, header, elements(), image_offset(), size() * sizeof(value_type));
+    }
+    /// Replace the elements by those of a snapshot.
+    /// Throws std::invalid_argument if the snapshot was taken from a different type or is truncated.
+    void restore(const void* buffer, size_type bytes) {
+        static_assert(std::is_trivially_copyable<value_type>::value, "Snapshots need trivially copyable elements.");
+        const size_type n = detail::read_snapshot_header(buffer, bytes, snapshot_header()).size;
+        const void* image = detail::snapshot_image(buffer, bytes, image_offset(), n * sizeof(value_type), 1);
+        this->clear();
+        std::memcpy(static_cast<void*>(elements()), image, n * sizeof(value_type));
+        _end_index = n;
+        this->record_insert(size(), size());
+    }
+
+    /// \brief Read-only view of a snapshot, which accesses the elements in place without copying them.
+    /// The buffer has to outlive the view and has to be aligned for value_type.
+    class View {
+    public:
+        typedef const _Tp* const_iterator;
+
+        /// Throws std::invalid_argument if the snapshot was taken from a different type, is truncated or misaligned
+        View(const void* buffer, size_type bytes) {
+            static_assert(std::is_trivially_copyable<value_type>::value, "Snapshots need trivially copyable elements.");
+            n = detail::read_snapshot_header(buffer, bytes, snapshot_header()).size;
+            first = static_cast<const _Tp*>(
+                    detail::snapshot_image(buffer, bytes, image_offset(), n * sizeof(value_type), alignof(value_type)));
+        }
+
+        size_type size() const noexcept {
+            return n;
+        }
+        bool empty() const noexcept {
+            return n == 0;
+        }
+        const_iterator begin() const noexcept {
+            return first;
+        }
+        const_iterator end() const noexcept {
+            return first + n;
         }
+        const_reference operator[](std::size_t idx) const CDT_CHECK_NOEXCEPT {
+            detail::check<std::out_of_range>(idx < n, "Out of range error.");
+            return first[idx];
+        }
+
+    private:
+        const _Tp* first;
+        size_type n;
+    };
+
+private:
+    static SnapshotHeader snapshot_header() {
+        return detail::snapshot_header<_Tp, _N, typename detail::MinimalIndex<_N>::type>(SnapshotHeader::FIXED_VECTOR);
+    }
+    static constexpr size_type image_offset() {
+        return detail::snapshot_offset(alignof(value_type));
     }
 
-    /// Check whether index is within bounds
-    void assert_valid(position_type idx) {
-        if (idx < 0 || idx >= _end_index) {
-            throw std::out_of_range("Out of range error.");
+    CDT_CONSTEXPR pointer elements() noexcept {
+        return this->data.ptr();
+    }
+    CDT_CONSTEXPR const_iterator elements() const noexcept {
+        return this->data.ptr();
+    }
+
+    /// Destroy all elements from new_end on, returns the number of destroyed elements
+    CDT_CONSTEXPR size_type truncate(iterator new_end) {
+        const size_type erased = end() - new_end;
+        if (!std::is_trivially_destructible<value_type>::value) {
+            for (iterator it = new_end; it != end(); ++it) {
+                it->~value_type();
+            }
         }
+        _end_index -= erased;
+        this->record_erase(erased);
+        return erased;
     }
 
-    /// Check whether there is still space left
-    void assert_capacity() {
-        if (size() >= capacity()) {
-            throw std::out_of_range("No space left in container.");
+    /// Trivially copyable elements are copied as one block of memory
+    CDT_CONSTEXPR void copy_from(const FixedVector& other, std::true_type) {
+        if (detail::is_constant_evaluated()) {
+            copy_from(other, std::false_type());
+            return;
         }
+        std::memcpy(static_cast<void*>(elements()), other.elements(), other.size() * sizeof(value_type));
+        _end_index = other._end_index;
+        this->record_insert(size(), size());
+    }
+    CDT_CONSTEXPR void copy_from(const FixedVector& other, std::false_type) {
+        for (const_iterator it = other.begin(); it != other.end(); ++it) {
+            this->emplace_back(*it);
+        }
+    }
+    CDT_CONSTEXPR void move_from(FixedVector& other, std::true_type) {
+        copy_from(other, std::true_type());
+        other.clear();
+    }
+    CDT_CONSTEXPR void move_from(FixedVector& other, std::false_type) {
+        for (iterator it = other.begin(); it != other.end(); ++it) {
+            this->emplace_back(std::move(*it));
+        }
+        other.clear();
     }
 
-    value_type data[_N];
-    position_type _end_index;
+    /// Check whether there is still space left
+    CDT_CONSTEXPR void assert_capacity() const CDT_CHECK_NOEXCEPT {
+        detail::check<std::out_of_range>(size() < capacity(), "No space left in container.");
+    }
 };
-} // Namespace cdt
\ No newline at end of file
+} // Namespace cdt
@@ -0,0 +1,66 @@
+#pragma once
+#include <array_list/arraylist.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace cdt {
+
+/// \brief Apply fn to every element of an ArrayList on up to n_threads threads, the calling one included.
+/// The slots are split into chunks of whole bitmap words, each thread runs ArrayList::for_each_unordered() on one
+/// of them, so every thread streams through its own part of the node array.
+/// Chunks are at least min_chunk slots large, smaller lists are processed on the calling thread alone.
+/// fn is called concurrently and has to access only the element it is passed. n_threads = 0 picks one per core.
+/// The first exception thrown by fn is rethrown once all threads have finished.
+template <typename _List, typename _Function>
+void for_each_parallel(_List& list, _Function fn, size_t n_threads = 0, size_t min_chunk = 4096) {
+    const size_t word_bits = 64;
+    const size_t slots = list.slot_count();
+    const size_t max_chunks = slots / std::max<size_t>(min_chunk, 1);
+    if (max_chunks > 1 && n_threads == 0) {
+        n_threads = std::thread::hardware_concurrency();
+    }
+    const size_t n_chunks = std::max<size_t>(std::min(n_threads, max_chunks), 1);
+    if (n_chunks == 1) {
+        list.for_each_unordered(fn);
+        return;
+    }
+    const size_t words = (slots + word_bits - 1) / word_bits;
+    auto chunk_begin = [=](size_t k) { return std::min(words * k / n_chunks * word_bits, slots); };
+
+    std::vector<std::exception_ptr> errors(n_chunks);
+    auto run = [&](size_t k) {
+        try {
+            list.for_each_unordered(chunk_begin(k), chunk_begin(k + 1), fn);
+        } catch (...) {
+            errors[k] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(n_chunks - 1);
+    size_t spawned = 1;
+    try {
+        for (; spawned < n_chunks; spawned++) {
+            threads.emplace_back(run, spawned);
+        }
+    } catch (const std::system_error&) {
+        // Out of threads, the remaining chunks are processed here
+    }
+    for (size_t k = spawned; k < n_chunks; k++) {
+        run(k);
+    }
+    run(0);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+} // Namespace cdt
@@ -0,0 +1,223 @@
+#pragma once
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <pthread.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+
+namespace cdt {
+
+/// \brief Places a container into a named POSIX shared memory segment, so that processes on one host share it.
+/// The containers address their nodes by index only, so they work at whatever address a process maps the segment,
+/// as long as the elements are trivially copyable and do not hold pointers themselves.
+/// Two ways to access the container are offered:
+/// - modify() and inspect() run a function while holding a process-shared robust mutex
+/// - read() copies the container without taking the mutex, guarded by a sequence counter (seqlock).
+///   Writers never wait for such readers, readers retry while a modification is in progress.
+///   After READ_ATTEMPTS failed attempts, a reader takes the mutex instead, which also recovers from a writer
+///   that died in the middle of a modification.
+/// All processes have to use the same container type, which open() only checks by the size of the segment.
+/// The segment outlives the processes until it is unlinked with remove().
+template <typename _Container>
+class SharedContainer {
+    static_assert(std::is_trivially_copyable<typename _Container::value_type>::value,
+                  "Shared containers need trivially copyable elements.");
+    static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Sequence counter has to be lock-free to be shared between processes.");
+
+public:
+    typedef _Container container_type;
+
+    enum : unsigned {
+        READ_ATTEMPTS = 1024 ///< Lock-free attempts of read(), before it falls back to the mutex
+    };
+
+    /// Create the segment name and construct an empty container in it. Throws std::system_error if it exists.
+    static SharedContainer create(const std::string& name) {
+        const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "Can not create shared segment " + name);
+        }
+        if (::ftruncate(fd, sizeof(Segment)) != 0) {
+            const int error = errno;
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            throw std::system_error(error, std::generic_category(), "Can not size shared segment " + name);
+        }
+        Segment* segment;
+        try {
+            segment = map(fd, name);
+        } catch (...) {
+            ::shm_unlink(name.c_str());
+            throw;
+        }
+        SharedContainer shared(segment);
+        new (shared.segment) Segment();
+        shared.segment->ready.store(Segment::MAGIC, std::memory_order_release);
+        return shared;
+    }
+
+    /// Attach to the segment name, which another process has created.
+    /// Throws std::system_error if it does not exist and std::runtime_error if it holds a different container type.
+    static SharedContainer open(const std::string& name) {
+        const int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "Can not open shared segment " + name);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || info.st_size != static_cast<off_t>(sizeof(Segment))) {
+            ::close(fd);
+            throw std::runtime_error("Shared segment " + name + " holds a different container type.");
+        }
+        SharedContainer shared(map(fd, name));
+        if (shared.segment->ready.load(std::memory_order_acquire) != Segment::MAGIC) {
+            throw std::runtime_error("Shared segment " + name + " is not initialized.");
+        }
+        return shared;
+    }
+
+    /// Unlink the segment name. Processes, which have it mapped, keep using it until they detach.
+    static void remove(const std::string& name) {
+        if (::shm_unlink(name.c_str()) != 0 && errno != ENOENT) {
+            throw std::system_error(errno, std::generic_category(), "Can not remove shared segment " + name);
+        }
+    }
+
+    SharedContainer(SharedContainer&& other) : segment(other.segment) {
+        other.segment = nullptr;
+    }
+    SharedContainer& operator=(SharedContainer&& other) {
+        std::swap(segment, other.segment);
+        return *this;
+    }
+    SharedContainer(const SharedContainer&) = delete;
+    SharedContainer& operator=(const SharedContainer&) = delete;
+    /// Detach, the container stays in the segment
+    ~SharedContainer() {
+        if (segment != nullptr) {
+            ::munmap(segment, sizeof(Segment));
+        }
+    }
+
+    /// Run fn on the container while holding the mutex. Seqlock readers see either none or all of its changes.
+    template <typename _Function>
+    auto modify(_Function fn) -> decltype(fn(std::declval<_Container&>())) {
+        WriteGuard guard(*segment);
+        return fn(segment->container);
+    }
+
+    /// Run fn on the container while holding the mutex, which excludes writers and other inspectors.
+    /// fn must only read, seqlock readers may copy the container at the same time. Const access to the containers
+    /// does not write, except for the usage counters with CDT_ENABLE_STATS, which read() may then copy torn.
+    template <typename _Function>
+    auto inspect(_Function fn) const -> decltype(fn(std::declval<const _Container&>())) {
+        LockGuard guard(*segment);
+        return fn(static_cast<const _Container&>(segment->container));
+    }
+
+    /// Copy the container into out without taking the mutex, retrying while a modification is in progress.
+    /// Takes the mutex after READ_ATTEMPTS failed attempts, so a writer, which died while modifying, is recovered
+    /// instead of being waited for forever.
+    void read(_Container& out) const {
+        for (unsigned attempt = 0; attempt < READ_ATTEMPTS; attempt++) {
+            const uint64_t before = segment->sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            // The copy may race with a writer, in which case it is discarded. Both sides only copy plain bytes.
+            std::memcpy(static_cast<void*>(&out), &segment->container, sizeof(_Container));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (segment->sequence.load(std::memory_order_relaxed) == before) {
+                return;
+            }
+        }
+        LockGuard guard(*segment);
+        std::memcpy(static_cast<void*>(&out), &segment->container, sizeof(_Container));
+    }
+
+    /// Number of completed modifications, allows to poll for changes
+    uint64_t version() const {
+        return segment->sequence.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    /// Layout of the shared memory
+    struct Segment {
+        enum : uint32_t { MAGIC = 0x4d484443 }; ///< "CDHM" in little endian byte order
+
+        Segment() : ready(0), sequence(0) {
+            pthread_mutexattr_t attributes;
+            pthread_mutexattr_init(&attributes);
+            pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+            pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+            pthread_mutex_init(&mutex, &attributes);
+            pthread_mutexattr_destroy(&attributes);
+        }
+
+        std::atomic<uint32_t> ready; ///< MAGIC once the segment is initialized
+        pthread_mutex_t mutex;
+        std::atomic<uint64_t> sequence; ///< Odd while a modification is in progress
+        _Container container;
+    };
+
+    /// Holds the mutex. If its previous owner died, the mutex is recovered and an interrupted modification is closed,
+    /// the container may be left in the state the owner died in.
+    struct LockGuard {
+        explicit LockGuard(Segment& s) : segment(s) {
+            const int result = pthread_mutex_lock(&segment.mutex);
+            if (result == EOWNERDEAD) {
+                pthread_mutex_consistent(&segment.mutex);
+                const uint64_t sequence = segment.sequence.load(std::memory_order_relaxed);
+                if (sequence & 1) {
+                    segment.sequence.store(sequence + 1, std::memory_order_release);
+                }
+            } else if (result != 0) {
+                throw std::system_error(result, std::generic_category(), "Can not lock shared segment");
+            }
+        }
+        ~LockGuard() {
+            pthread_mutex_unlock(&segment.mutex);
+        }
+        Segment& segment;
+    };
+
+    /// Holds the mutex and keeps the sequence odd while the container is modified
+    struct WriteGuard : LockGuard {
+        explicit WriteGuard(Segment& s) : LockGuard(s), sequence(s.sequence.load(std::memory_order_relaxed)) {
+            s.sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+        ~WriteGuard() {
+            this->segment.sequence.store(sequence + 2, std::memory_order_release);
+        }
+        const uint64_t sequence;
+    };
+
+    static Segment* map(int fd, const std::string& name) {
+        void* memory = ::mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const int error = errno;
+        ::close(fd);
+        if (memory == MAP_FAILED) {
+            throw std::system_error(error, std::generic_category(), "Can not map shared segment " + name);
+        }
+        return static_cast<Segment*>(memory);
+    }
+
+    explicit SharedContainer(Segment* s) : segment(s) {
+    }
+
+    Segment* segment;
+};
+} // Namespace cdt
@@ -0,0 +1,178 @@
+#pragma once
+#include <array_list/detail/check_policy.hpp>
+#include <array_list/detail/slot_table.hpp>
+#include <array_list/fixedvector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+namespace cdt {
+
+/// \brief A container, which hands out stable handles instead of iterators
+/// - supports insertion and deletion in constant time
+/// - lookup by handle takes constant time and detects handles of erased elements
+/// - elements are stored densely, so iteration only visits live elements
+/// - does not guarantee order
+/// A handle holds the index of a slot and the generation of that slot, see detail::SlotTable.
+/// Handles of erased elements never match again, until the 32 bit generation of their slot wraps around.
+
+template <typename _Tp, size_t _N>
+class SlotMap {
+    typedef detail::SlotTable<_N, SlotMap> table_type;
+
+public:
+    // types:
+    typedef SlotMap<_Tp, _N> list_type;
+    typedef _Tp value_type;
+    typedef size_t size_type;
+    typedef typename table_type::position_type position_type;
+    typedef typename table_type::generation_type generation_type;
+    typedef _Tp* pointer;
+    typedef const _Tp* const_pointer;
+    typedef _Tp& reference;
+    typedef const _Tp& const_reference;
+    typedef typename FixedVector<_Tp, _N>::iterator iterator;
+    typedef typename FixedVector<_Tp, _N>::const_iterator const_iterator;
+
+    /// Stable reference to an element. A default constructed handle refers to no element.
+    typedef typename table_type::Handle Handle;
+
+    enum {
+        MAX_SIZE = _N /// Maximum size, defined at compile time
+    };
+
+public:
+    // construct/copy/destroy:
+    SlotMap(){};
+    SlotMap(const SlotMap& other) : values(other.values) {
+        table.copy_from(other.table, values.size());
+    }
+    // The count is taken from values once it holds the elements, other.values may already be moved from.
+    // other releases its slots instead of forgetting them, so its old handles stay stale once it is refilled.
+    SlotMap(SlotMap&& other) : values(std::move(other.values)) {
+        table.copy_from(other.table, values.size());
+        other.table.release_all(values.size());
+    }
+    SlotMap& operator=(const SlotMap& other) {
+        if (this != &other) {
+            values = other.values;
+            table.copy_from(other.table, values.size());
+        }
+        return *this;
+    }
+    SlotMap& operator=(SlotMap&& other) {
+        if (this != &other) {
+            values = std::move(other.values);
+            table.copy_from(other.table, values.size());
+            other.table.release_all(values.size());
+        }
+        return *this;
+    }
+
+    size_type size() const noexcept {
+        return values.size();
+    };
+    size_type capacity() const noexcept {
+        return MAX_SIZE;
+    };
+    bool empty() const noexcept {
+        return values.empty();
+    };
+
+    /// Iterators visit the live elements densely, in no particular order
+    iterator begin() noexcept {
+        return values.begin();
+    };
+    iterator end() noexcept {
+        return values.end();
+    };
+    const_iterator begin() const noexcept {
+        return values.begin();
+    };
+    const_iterator end() const noexcept {
+        return values.end();
+    };
+
+    /// Copy element into container
+    Handle insert(const value_type& x) {
+        return this->emplace(x);
+    }
+    /// Move element into container
+    Handle insert(value_type&& x) {
+        return this->emplace(std::move(x));
+    }
+    /// Create new object in container and return its handle
+    template <typename... _Args>
+    Handle emplace(_Args&&... __args) {
+        detail::check<std::length_error>(size() < capacity(), "No space left in SlotMap.");
+        values.emplace_back(std::forward<_Args>(__args)...);
+        const size_type last = values.size() - 1;
+        table.place(last, table.acquire());
+        return table.handle_at(last);
+    }
+
+    /// Erase the element of handle, false if the handle is stale. The last element takes its place in iteration order.
+    bool erase(Handle handle) {
+        if (!contains(handle)) {
+            return false;
+        }
+        const size_type dense = table.position(handle);
+        const size_type last = values.size() - 1;
+        values.erase(dense);
+        table.place(dense, table.owner(last));
+        table.release(handle.index);
+        return true;
+    }
+    /// Erase the element it points to, returns an iterator to the element that took its place
+    iterator erase(const_iterator it) {
+        erase(handle_of(it));
+        return begin() + (it - begin());
+    }
+
+    /// Whether handle refers to a live element, stale and default constructed handles do not
+    bool contains(Handle handle) const noexcept {
+        return table.contains(handle);
+    }
+    /// Pointer to the element of handle, nullptr if the handle is stale
+    pointer find(Handle handle) noexcept {
+        return contains(handle) ? values.begin() + table.position(handle) : nullptr;
+    }
+    const_pointer find(Handle handle) const noexcept {
+        return contains(handle) ? values.begin() + table.position(handle) : nullptr;
+    }
+    /// Access the element of handle, checked according to CDT_CHECK_POLICY
+    reference operator[](Handle handle) CDT_CHECK_NOEXCEPT {
+        detail::check<std::out_of_range>(contains(handle), "Handle is stale.");
+        return values.begin()[table.position(handle)];
+    }
+    const_reference operator[](Handle handle) const CDT_CHECK_NOEXCEPT {
+        detail::check<std::out_of_range>(contains(handle), "Handle is stale.");
+        return values.begin()[table.position(handle)];
+    }
+    /// Access the element of handle, always throws on a stale handle
+    reference at(Handle handle) {
+        detail::require<std::out_of_range>(contains(handle), "Handle is stale.");
+        return values.begin()[table.position(handle)];
+    }
+    const_reference at(Handle handle) const {
+        detail::require<std::out_of_range>(contains(handle), "Handle is stale.");
+        return values.begin()[table.position(handle)];
+    }
+
+    /// Handle of the element it points to
+    Handle handle_of(const_iterator it) const noexcept {
+        return table.handle_at(static_cast<size_type>(it - values.begin()));
+    }
+
+    /// Erase all elements, all handles become stale
+    void clear() {
+        table.release_all(values.size());
+        values.clear();
+    }
+
+private:
+    FixedVector<_Tp, _N> values; ///< Live elements, densely packed
+    table_type table;
+};
+} // Namespace cdt
@@ -0,0 +1,120 @@
+#pragma once
+#include <array_list/detail/index_type.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace cdt {
+
+/// \brief A lock-free pool of the slot indices 0.._N-1, shared by any number of threads
+/// - allocate and deallocate are lock-free and take constant time without contention
+/// - works on indices only, pair it with an array to hold the payloads
+/// Released slots are kept on a Treiber stack, which is threaded through a link array.
+/// The head carries a tag, that changes on every update, so a stale head can never be swapped in (ABA).
+/// Slots that have never been handed out are taken from an untouched watermark, so construction takes constant time.
+
+template <size_t _N>
+class ConcurrentSlotPool {
+public:
+    // types:
+    typedef size_t size_type;
+    typedef typename detail::MinimalIndex<_N>::type position_type;
+
+    static_assert(_N < (static_cast<uint64_t>(1) << 32), "ConcurrentSlotPool packs slot indices into 32 bit.");
+
+public:
+    // construct/copy/destroy:
+    ConcurrentSlotPool() : head(pack(0, _N)), untouched(0), count(0){};
+    ConcurrentSlotPool(const ConcurrentSlotPool&) = delete;
+    ConcurrentSlotPool& operator=(const ConcurrentSlotPool&) = delete;
+
+    /// Acquire a slot, throws if all slots are in use
+    position_type allocate() {
+        position_type i;
+        if (!try_allocate(i)) {
+            throw std::length_error("No space left in ConcurrentSlotPool.");
+        }
+        return i;
+    }
+
+    /// Acquire a slot, false if all slots are in use
+    bool try_allocate(position_type& i) {
+        // Take a released slot first, otherwise one that has never been used.
+        // Slots may be released while the watermark is taken, so the stack is checked again once it is exhausted.
+        return pop_released(i) || take_untouched(i) || pop_released(i);
+    }
+
+    /// Release a slot, which has been acquired before
+    void deallocate(position_type i) {
+        count.fetch_sub(1, std::memory_order_relaxed);
+        uint64_t old_head = head.load(std::memory_order_relaxed);
+        uint64_t new_head;
+        do {
+            links[i].store(index(old_head), std::memory_order_relaxed);
+            new_head = pack(tag(old_head) + 1, i);
+        } while (!head.compare_exchange_weak(old_head, new_head, std::memory_order_release,
+                                             std::memory_order_relaxed));
+    }
+
+    /// Number of slots in use, only a snapshot while other threads are active
+    size_type size() const {
+        return count.load(std::memory_order_relaxed);
+    }
+    size_type max_size() const {
+        return _N;
+    }
+    bool empty() const {
+        return size() == 0;
+    }
+
+private:
+    /// Pop a slot from the stack of released slots, false if it is empty
+    bool pop_released(position_type& i) {
+        uint64_t old_head = head.load(std::memory_order_acquire);
+        while (index(old_head) != _N) {
+            const position_type top = index(old_head);
+            const uint64_t new_head = pack(tag(old_head) + 1, links[top].load(std::memory_order_relaxed));
+            if (head.compare_exchange_weak(old_head, new_head, std::memory_order_acq_rel,
+                                           std::memory_order_acquire)) {
+                i = top;
+                count.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+    /// Take the next slot below the watermark, false if all slots have been used before
+    bool take_untouched(position_type& i) {
+        size_type u = untouched.load(std::memory_order_relaxed);
+        while (u < _N) {
+            if (untouched.compare_exchange_weak(u, u + 1, std::memory_order_relaxed)) {
+                i = static_cast<position_type>(u);
+                count.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static uint64_t pack(uint32_t tag, size_type index) {
+        return (static_cast<uint64_t>(tag) << 32) | static_cast<uint32_t>(index);
+    }
+    static uint32_t tag(uint64_t packed) {
+        return static_cast<uint32_t>(packed >> 32);
+    }
+    static position_type index(uint64_t packed) {
+        return static_cast<position_type>(packed & 0xffffffffu);
+    }
+
+    static constexpr size_t cache_line = 64;
+
+    alignas(cache_line) std::atomic<uint64_t> head; ///< Tag and index of the first released slot, index _N if none
+    std::atomic<size_type> untouched;               ///< Slots from here on have never been allocated
+    alignas(cache_line) std::atomic<size_type> count;         ///< Slots in use
+    alignas(cache_line) std::atomic<position_type> links[_N]; ///< Next released slot, only valid for released slots
+};
+
+template <size_t _N>
+constexpr size_t ConcurrentSlotPool<_N>::cache_line;
+} // Namespace cdt
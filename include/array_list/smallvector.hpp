@@ -0,0 +1,392 @@
+#pragma once
+#include <algorithm>
+#include <array_list/detail/check_policy.hpp>
+#include <array_list/detail/compiler.hpp>
+#include <array_list/detail/constexpr.hpp>
+#include <array_list/detail/uninitialized.hpp>
+#include <array_list/detail/vector_algorithms.hpp>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace cdt {
+
+/// \brief SmallVector overflow policy, insertions into a full vector fail like in FixedVector
+struct ThrowOnOverflow {};
+
+/// \brief SmallVector overflow policy, which moves the elements to the heap once the inline storage is full.
+/// The heap storage doubles whenever it is full.
+struct SpillToHeap {};
+
+/// \brief SmallVector overflow policy, which drops the first element to make room.
+/// The remaining elements move forward by one, so the vector keeps the _N latest elements,
+/// as long as elements are only erased from the back or with the order preserving remove() and erase_if().
+/// Each drop moves all _N - 1 remaining elements, i.e. an insertion into a full vector takes O(_N).
+/// This keeps the elements contiguous for iteration and search, but suits small _N or rare overflows only.
+struct DropOldest {};
+
+/// Overflow counters of a SmallVector, they start at zero on construction and are not copied along with the elements.
+/// Unlike UsageStats, they are always recorded, as only insertions into a full vector touch them.
+struct SpillStats {
+    SpillStats() : high_water_mark(0), overflows(0), spills(0), reallocations(0), drops(0){};
+
+    size_t high_water_mark; ///< Largest size reached
+    size_t overflows;       ///< Insertions, which found the vector full
+    size_t spills;          ///< Moves of the elements from the inline storage to the heap
+    size_t reallocations;   ///< Growths of the heap storage after a spill
+    size_t drops;           ///< Elements dropped to make room
+};
+
+/// \brief A FixedVector, which handles insertions beyond its capacity according to _Overflow
+/// - up to _N elements are stored inline, without any allocation
+/// - supports insertion only at the end
+/// - allows deletion anywhere
+/// - does not guarantee order
+/// - allows random access
+/// With SpillToHeap (default), _N can be sized for the common case, as rare bursts spill to the heap.
+/// spill_stats() tells how often that happens. The heap storage is kept until shrink_to_fit().
+/// Search and removal by value are shared with FixedVector, see detail::VectorAlgorithms.
+
+template <typename _Tp, size_t _N, typename _Overflow = SpillToHeap>
+class SmallVector : public detail::VectorAlgorithms<SmallVector<_Tp, _N, _Overflow>, _Tp> {
+    static_assert(_N > 0, "SmallVector needs inline storage for at least one element.");
+    typedef detail::VectorAlgorithms<SmallVector<_Tp, _N, _Overflow>, _Tp> algorithms_type;
+    friend algorithms_type;
+    using algorithms_type::assert_valid;
+
+public:
+    // types:
+    typedef SmallVector<_Tp, _N, _Overflow> list_type;
+    typedef _Tp value_type;
+    typedef _Overflow overflow_policy;
+    typedef size_t size_type;
+    typedef size_t position_type;
+    typedef size_t difference_type;
+    typedef _Tp* pointer;
+    typedef _Tp& reference;
+    typedef const _Tp& const_reference;
+    typedef _Tp* iterator;
+    typedef const _Tp* const_iterator;
+
+    enum {
+        INLINE_SIZE = _N /// Elements stored without allocation, defined at compile time
+    };
+
+public:
+    // construct/copy/destroy:
+    SmallVector() : n(0), cap(_N) {
+        first = local.ptr();
+    }
+    SmallVector(const SmallVector& other) : SmallVector() {
+        copy_from(other);
+    }
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<_Tp>::value) : SmallVector() {
+        move_from(other);
+    }
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            this->clear();
+            copy_from(other);
+        }
+        return *this;
+    }
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<_Tp>::value) {
+        if (this != &other) {
+            this->clear();
+            move_from(other);
+        }
+        return *this;
+    }
+    ~SmallVector() {
+        this->clear();
+        release_heap();
+    }
+
+    size_type size() const noexcept {
+        return n;
+    };
+    /// Elements, which fit without a reallocation: _N until the first spill
+    size_type capacity() const noexcept {
+        return cap;
+    };
+    bool empty() const noexcept {
+        return n == 0;
+    };
+    /// Whether the elements are stored inline, i.e. not spilled to the heap
+    bool is_inline() const noexcept {
+        return first == local.ptr();
+    }
+
+    /// Overflows recorded since construction or the last reset_spill_stats()
+    SpillStats spill_stats() const noexcept {
+        SpillStats stats = counters;
+        stats.high_water_mark = std::max<size_t>(stats.high_water_mark, n);
+        return stats;
+    }
+    /// Start over, the high-water mark restarts from the current size
+    void reset_spill_stats() noexcept {
+        counters = SpillStats();
+        counters.high_water_mark = n;
+    }
+
+    /// Make room for at least m elements. Only SpillToHeap grows beyond _N, the other policies throw std::length_error.
+    void reserve(size_type m) {
+        if (m > cap) {
+            detail::require<std::length_error>(std::is_same<_Overflow, SpillToHeap>::value,
+                                               "SmallVector cannot grow beyond its inline storage.");
+            reallocate(m);
+        }
+    }
+    /// Move spilled elements back into the inline storage and free the heap storage, if they fit
+    void shrink_to_fit() {
+        if (!is_inline() && n <= _N) {
+            relocate(first, n, local.ptr());
+            release_heap();
+            first = local.ptr();
+            cap = _N;
+        }
+    }
+
+    /// Iterator element access:
+    iterator begin() noexcept {
+        return first;
+    };
+    iterator end() noexcept {
+        return first + n;
+    };
+    const_iterator begin() const noexcept {
+        return first;
+    };
+    const_iterator end() const noexcept {
+        return first + n;
+    };
+
+    /// Reference element access:
+    reference front() noexcept {
+        return *first;
+    }
+    const_reference front() const noexcept {
+        return *first;
+    }
+    reference back() noexcept {
+        return first[n - 1];
+    }
+    const_reference back() const noexcept {
+        return first[n - 1];
+    }
+
+    /// Access container elements by subscript, checked according to CDT_CHECK_POLICY
+    reference operator[](std::size_t idx) CDT_CHECK_NOEXCEPT {
+        assert_valid(idx);
+        return first[idx];
+    }
+    const_reference operator[](std::size_t idx) const CDT_CHECK_NOEXCEPT {
+        assert_valid(idx);
+        return first[idx];
+    }
+    /// Access container elements by subscript, always throws on an invalid idx
+    reference at(std::size_t idx) {
+        detail::require<std::out_of_range>(idx < n, "Out of range error.");
+        return first[idx];
+    }
+    const_reference at(std::size_t idx) const {
+        detail::require<std::out_of_range>(idx < n, "Out of range error.");
+        return first[idx];
+    }
+
+    /// Copy element into container
+    void push_back(const value_type& x) {
+        this->emplace_back(x);
+    }
+    /// Move element into container
+    void push_back(value_type&& x) {
+        this->emplace_back(std::move(x));
+    }
+    /// Create new object in container, a full vector is handled according to _Overflow
+    template <typename... _Args>
+    reference emplace_back(_Args&&... __args) {
+        if (CDT_UNLIKELY(n == cap)) {
+            ++counters.overflows;
+            return emplace_overflow(_Overflow(), std::forward<_Args>(__args)...);
+        }
+        return emplace_unchecked(std::forward<_Args>(__args)...);
+    }
+
+    /// Erase last element
+    void pop_back() {
+        this->erase(n - 1);
+    }
+    /// Erase first element
+    void pop_front() {
+        this->erase(begin());
+    }
+    /// Erase arbitrary element
+    void erase(position_type position) {
+        this->erase(first + position);
+    }
+    /// Erase arbitrary element, the last element takes its place
+    void erase(iterator position) {
+        assert_valid(position);
+        record_peak();
+        iterator last = end() - 1;
+        if (position != last) {
+            *position = std::move(*last);
+        }
+        last->~value_type();
+        --n;
+    }
+
+    /// Erase all elements, spilled elements keep their heap storage until shrink_to_fit()
+    void clear() {
+        truncate(begin());
+    }
+
+private:
+    template <typename... _Args>
+    reference emplace_unchecked(_Args&&... __args) {
+        detail::construct_at(first + n, std::forward<_Args>(__args)...);
+        return first[n++];
+    }
+
+    template <typename... _Args>
+    reference emplace_overflow(ThrowOnOverflow, _Args&&... __args) {
+        detail::check<std::out_of_range>(false, "No space left in container.");
+        return emplace_unchecked(std::forward<_Args>(__args)...); // Undefined behavior without checks, as in FixedVector
+    }
+    /// Construct the new element in the new storage first, as __args may refer to an element of this vector
+    template <typename... _Args>
+    CDT_NOINLINE reference emplace_overflow(SpillToHeap, _Args&&... __args) {
+        const size_type new_cap = 2 * cap;
+        pointer heap = std::allocator<_Tp>().allocate(new_cap);
+        try {
+            detail::construct_at(heap + n, std::forward<_Args>(__args)...);
+        } catch (...) {
+            std::allocator<_Tp>().deallocate(heap, new_cap);
+            throw;
+        }
+        try {
+            take_storage(heap, new_cap);
+        } catch (...) {
+            heap[n].~value_type();
+            std::allocator<_Tp>().deallocate(heap, new_cap);
+            throw;
+        }
+        return first[n++];
+    }
+    /// Construct the new element before dropping the first one, as __args may refer to it
+    template <typename... _Args>
+    CDT_NOINLINE reference emplace_overflow(DropOldest, _Args&&... __args) {
+        value_type x(std::forward<_Args>(__args)...);
+        std::move(first + 1, first + n, first);
+        first[n - 1] = std::move(x);
+        ++counters.drops;
+        return first[n - 1];
+    }
+
+    /// Move the elements to new heap storage for m elements
+    void reallocate(size_type m) {
+        pointer heap = std::allocator<_Tp>().allocate(m);
+        try {
+            take_storage(heap, m);
+        } catch (...) {
+            std::allocator<_Tp>().deallocate(heap, m);
+            throw;
+        }
+    }
+    /// Relocate the elements into heap, which holds m elements, and make it the storage
+    void take_storage(pointer heap, size_type m) {
+        relocate(first, n, heap);
+        if (is_inline()) {
+            ++counters.spills;
+        } else {
+            ++counters.reallocations;
+            release_heap();
+        }
+        first = heap;
+        cap = m;
+    }
+    void release_heap() noexcept {
+        if (!is_inline()) {
+            std::allocator<_Tp>().deallocate(first, cap);
+        }
+    }
+
+    /// Move k elements from from into the uninitialized to and destroy them at from.
+    /// Elements with a throwing move are copied, so from is left intact if that throws.
+    static void relocate(pointer from, size_type k, pointer to) {
+        if (std::is_trivially_copyable<value_type>::value) {
+            std::memcpy(static_cast<void*>(to), from, k * sizeof(value_type));
+            return;
+        }
+        size_type i = 0;
+        try {
+            for (; i < k; i++) {
+                detail::construct_at(to + i, std::move_if_noexcept(from[i]));
+            }
+        } catch (...) {
+            for (size_type j = 0; j < i; j++) {
+                to[j].~value_type();
+            }
+            throw;
+        }
+        for (i = 0; i < k; i++) {
+            from[i].~value_type();
+        }
+    }
+
+    void copy_from(const SmallVector& other) {
+        reserve(other.n);
+        if (std::is_trivially_copyable<value_type>::value) {
+            std::memcpy(static_cast<void*>(first), other.first, other.n * sizeof(value_type));
+            n = other.n;
+        } else {
+            for (const_iterator it = other.begin(); it != other.end(); ++it) {
+                emplace_unchecked(*it);
+            }
+        }
+    }
+    /// Spilled elements are taken over with their storage, inline elements are moved one by one
+    void move_from(SmallVector& other) {
+        if (other.is_inline()) {
+            relocate(other.first, other.n, first);
+            n = other.n;
+        } else {
+            release_heap();
+            first = other.first;
+            cap = other.cap;
+            n = other.n;
+            other.first = other.local.ptr();
+            other.cap = _N;
+        }
+        other.record_peak();
+        other.n = 0;
+    }
+
+    /// Destroy all elements from new_end on, returns the number of destroyed elements
+    size_type truncate(iterator new_end) {
+        record_peak();
+        const size_type erased = end() - new_end;
+        if (!std::is_trivially_destructible<value_type>::value) {
+            for (iterator it = new_end; it != end(); ++it) {
+                it->~value_type();
+            }
+        }
+        n -= erased;
+        return erased;
+    }
+
+    /// The size only grows by insertion, so the high-water mark is updated before it shrinks instead of on every insertion
+    void record_peak() noexcept {
+        counters.high_water_mark = std::max<size_t>(counters.high_water_mark, n);
+    }
+
+    detail::UninitializedArray<_Tp, _N> local; ///< Inline storage
+    pointer first;                             ///< Storage in use, local or on the heap
+    size_type n;
+    size_type cap;
+    SpillStats counters;
+};
+} // Namespace cdt
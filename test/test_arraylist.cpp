@@ -1,6 +1,10 @@
 #include <array_list/arraylist.hpp>
+#include <algorithm>
 #include <cmath>
+#include <string>
+#include <vector>
 #include "gtest/gtest.h"
+#include "tracked.hpp"
 
 // Set up fixtures
 class EmptyFixture : public ::testing::Test {
@@ -72,6 +76,27 @@ TEST_F(FullFixture, MaxSize) {
 //               sizeof(l));               // Actual size
 // }
 
+TEST(ArrayListIndexWidth, PositionType) {
+    ASSERT_EQ(1, sizeof(cdt::ArrayList<int, 255>::position_type));
+    ASSERT_EQ(2, sizeof(cdt::ArrayList<int, 256>::position_type));
+    ASSERT_EQ(2, sizeof(cdt::ArrayList<int, 65535>::position_type));
+    ASSERT_EQ(4, sizeof(cdt::ArrayList<int, 65536>::position_type));
+}
+
+TEST(ArrayListIndexWidth, FillLargestNarrowCapacity) {
+    cdt::ArrayList<int, 255> l;
+    for (int i = 0; i < 255; i++) {
+        l.push_back(i);
+    }
+    ASSERT_THROW(l.push_back(0), std::length_error);
+    ASSERT_EQ(254, l.back());
+    int i = 0;
+    for (auto it = l.begin(); it != l.end(); ++it) {
+        ASSERT_EQ(i++, *it);
+    }
+    ASSERT_EQ(255, i);
+}
+
 /* ------------------------------------------------------------- */
 TEST_F(FullFixture, SubscriptAccess) {
     for (size_t i = 0; i < capacity; i++) {
@@ -80,6 +105,16 @@ TEST_F(FullFixture, SubscriptAccess) {
     ASSERT_THROW(l[capacity], std::out_of_range);
 }
 
+TEST_F(FullFixture, AtAccess) {
+    for (size_t i = 0; i < capacity; i++) {
+        ASSERT_EQ(i, l.at(i));
+    }
+    ASSERT_THROW(l.at(capacity), std::out_of_range);
+    const auto& cl = l;
+    ASSERT_EQ(capacity - 1, cl.at(capacity - 1));
+    ASSERT_THROW(cl.at(capacity), std::out_of_range);
+}
+
 TEST_F(FullFixture, FrontAccess) {
     ASSERT_EQ(0, l.front());
 }
@@ -118,6 +153,24 @@ TEST_F(FullFixture, EraseMiddle) {
     ASSERT_EQ(2, *(++l.begin()));
 }
 
+TEST_F(FullFixture, EraseReturnsNext) {
+    auto it = l.erase(++l.begin());
+    ASSERT_EQ(2, *it);
+    it = l.erase(--l.end());
+    ASSERT_EQ(l.end(), it);
+}
+
+TEST_F(FullFixture, EraseAndRefill) {
+    l.erase(++l.begin());
+    l.erase(--l.end());
+    l.push_back(10);
+    l.push_front(11);
+    ASSERT_EQ(capacity, l.size());
+    ASSERT_THROW(l.push_back(0), std::length_error);
+    std::vector<int> expected{11, 0, 2, 3, 10};
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+}
+
 TEST_F(FullFixture, EraseEnd) {
     ASSERT_THROW(l.erase(l.end()), std::out_of_range);
 }
@@ -177,4 +230,731 @@ TEST_F(FullFixture, IteratorDecrementPostfix) {
     for (size_t i = l.size(); i > 0; i--) {
         ASSERT_EQ(i - 1, *(it--));
     }
-}
\ No newline at end of file
+}
+/* ------------------------------------------------------------- */
+TEST(ArrayListLifetime, NoPayloadConstructedUpFront) {
+    Tracked::alive = 0;
+    cdt::ArrayList<Tracked, 10> l;
+    ASSERT_EQ(0, Tracked::alive);
+}
+
+TEST(ArrayListLifetime, EmplaceConstructsInPlace) {
+    Tracked::alive = 0;
+    cdt::ArrayList<Tracked, 10> l;
+    l.emplace_back(1);
+    l.emplace_front(0);
+    l.emplace(l.end(), 2);
+    ASSERT_EQ(3, Tracked::alive);
+    int i = 0;
+    for (auto it = l.begin(); it != l.end(); ++it) {
+        ASSERT_EQ(i++, it->value);
+    }
+}
+
+TEST(ArrayListLifetime, EraseAndClearDestroy) {
+    Tracked::alive = 0;
+    {
+        cdt::ArrayList<Tracked, 10> l;
+        for (int i = 0; i < 5; i++) {
+            l.emplace_back(i);
+        }
+        l.erase(l.begin());
+        l.pop_back();
+        ASSERT_EQ(3, Tracked::alive);
+        l.clear();
+        ASSERT_EQ(0, Tracked::alive);
+        l.emplace_back(7);
+    }
+    ASSERT_EQ(0, Tracked::alive);
+}
+
+TEST(ArrayListLifetime, Copy) {
+    Tracked::alive = 0;
+    cdt::ArrayList<Tracked, 10> l;
+    for (int i = 0; i < 5; i++) {
+        l.emplace_back(i);
+    }
+    cdt::ArrayList<Tracked, 10> copy(l);
+    ASSERT_EQ(10, Tracked::alive);
+    ASSERT_EQ(5, copy.size());
+    copy.pop_front();
+    l = copy;
+    ASSERT_EQ(8, Tracked::alive);
+    ASSERT_EQ(1, l.front().value);
+}
+
+/* ------------------------------------------------------------- */
+TEST(ArrayListSplitLayout, InsertEraseIterate) {
+    cdt::ArrayList<int, 5, cdt::SplitLayout> l;
+    for (int i = 0; i < 5; i++) {
+        l.push_back(i);
+    }
+    ASSERT_THROW(l.push_back(5), std::length_error);
+    l.erase(++l.begin());
+    l.pop_front();
+    l.push_front(10);
+    std::vector<int> expected{10, 2, 3, 4};
+    ASSERT_EQ(expected.size(), l.size());
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+    ASSERT_EQ(4, l.back());
+    ASSERT_EQ(3, l[2]);
+}
+
+TEST(ArrayListSplitLayout, Lifetime) {
+    Tracked::alive = 0;
+    {
+        cdt::ArrayList<Tracked, 10, cdt::SplitLayout> l;
+        for (int i = 0; i < 5; i++) {
+            l.emplace_back(i);
+        }
+        cdt::ArrayList<Tracked, 10, cdt::SplitLayout> copy(l);
+        ASSERT_EQ(10, Tracked::alive);
+        l.clear();
+        ASSERT_EQ(5, Tracked::alive);
+    }
+    ASSERT_EQ(0, Tracked::alive);
+}
+
+/* ------------------------------------------------------------- */
+TEST_F(FullFixture, SubscriptAfterModification) {
+    ASSERT_EQ(3, l[3]);
+    l.erase(l.nth(1));
+    ASSERT_EQ(3, l[2]);
+    l.push_front(10);
+    ASSERT_EQ(10, l[0]);
+    ASSERT_EQ(3, l[3]);
+    ASSERT_EQ(2, l[2]);
+    ASSERT_THROW(l[l.size()], std::out_of_range);
+}
+
+TEST_F(FullFixture, ConstSubscript) {
+    const auto& cl = l;
+    for (size_t i = capacity; i > 0; i--) {
+        ASSERT_EQ(i - 1, cl[i - 1]);
+    }
+    ASSERT_THROW(cl[capacity], std::out_of_range);
+}
+
+TEST_F(FullFixture, Nth) {
+    ASSERT_EQ(l.begin(), l.nth(0));
+    ASSERT_EQ(l.end(), l.nth(capacity));
+    ASSERT_EQ(2, *l.nth(2));
+    ASSERT_THROW(l.nth(capacity + 1), std::out_of_range);
+}
+
+TEST_F(FullFixture, IndexOf) {
+    size_t i = 0;
+    for (auto it = l.begin(); it != l.end(); ++it) {
+        ASSERT_EQ(i++, l.index_of(it));
+    }
+    ASSERT_EQ(capacity, l.index_of(l.end()));
+    auto it = ++(++l.begin());
+    l[4];
+    ASSERT_EQ(2, l.index_of(it));
+    l[0];
+    ASSERT_EQ(2, l.index_of(it));
+}
+
+TEST_F(FullFixture, AdvanceAndDistance) {
+    ASSERT_EQ(3, *l.advance(l.begin(), 3));
+    ASSERT_EQ(1, *l.advance(l.end(), -4));
+    auto it = ++l.begin();
+    ASSERT_EQ(4, *l.advance(it, 3));
+    ASSERT_EQ(0, *l.advance(it, -1));
+    ASSERT_EQ(capacity, l.distance(l.begin(), l.end()));
+    ASSERT_EQ(-1, l.distance(it, l.begin()));
+    ASSERT_EQ(3, l.distance(it, --l.end()));
+}
+
+/* ------------------------------------------------------------- */
+TEST_F(EmptyFixture, InsertRange) {
+    std::vector<int> v{1, 2, 3};
+    auto it = l.insert(l.end(), v.begin(), v.end());
+    ASSERT_EQ(1, *it);
+    l.insert(++l.begin(), {7, 8});
+    std::vector<int> expected{1, 7, 8, 2, 3};
+    ASSERT_EQ(expected.size(), l.size());
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+    ASSERT_EQ(--l.end(), l.insert(--l.end(), v.begin(), v.begin()));
+}
+
+TEST_F(EmptyFixture, InsertRangeOverfill) {
+    l.push_back(0);
+    std::vector<int> v{1, 2, 3, 4, 5};
+    ASSERT_THROW(l.insert(l.end(), v.begin(), v.end()), std::length_error);
+    ASSERT_EQ(1, l.size());
+    ASSERT_EQ(0, l.back());
+    l.insert(l.begin(), v.begin(), v.end() - 1);
+    ASSERT_EQ(capacity, l.size());
+}
+
+TEST_F(EmptyFixture, InsertCopies) {
+    l.push_back(0);
+    l.insert(l.begin(), 3, 9);
+    std::vector<int> expected{9, 9, 9, 0};
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+    ASSERT_THROW(l.insert(l.begin(), 2, 9), std::length_error);
+    ASSERT_EQ(4, l.size());
+}
+
+TEST_F(FullFixture, Assign) {
+    l.assign({5, 6});
+    ASSERT_EQ(2, l.size());
+    ASSERT_EQ(5, l.front());
+    l.assign(capacity, 1);
+    ASSERT_EQ(capacity, l.size());
+    ASSERT_EQ(1, l.back());
+}
+
+TEST_F(FullFixture, EraseRange) {
+    auto it = l.erase(++l.begin(), --l.end());
+    ASSERT_EQ(4, *it);
+    ASSERT_EQ(2, l.size());
+    ASSERT_EQ(0, l.front());
+    ASSERT_EQ(4, l.back());
+    l.insert(it, {1, 2, 3});
+    for (size_t i = 0; i < capacity; i++) {
+        ASSERT_EQ(i, l[i]);
+    }
+    ASSERT_EQ(l.end(), l.erase(l.begin(), l.end()));
+    ASSERT_TRUE(l.empty());
+}
+
+TEST_F(FullFixture, SpliceWithinList) {
+    // Move [1, 3) to the end
+    l.splice(l.end(), l, l.nth(1), l.nth(3));
+    std::vector<int> expected{0, 3, 4, 1, 2};
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+    // Move the last element to the front
+    l.splice(l.begin(), l, --l.end());
+    expected = {2, 0, 3, 4, 1};
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+    // Splicing a range in front of itself does nothing
+    l.splice(l.nth(1), l, l.nth(1), l.nth(3));
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+    ASSERT_EQ(capacity, l.size());
+}
+
+TEST_F(FullFixture, SpliceAcrossLists) {
+    cdt::ArrayList<int, capacity> other;
+    other.splice(other.end(), l, l.nth(1), l.nth(3));
+    ASSERT_EQ(2, other.size());
+    ASSERT_EQ(3, l.size());
+    ASSERT_EQ(1, other.front());
+    ASSERT_EQ(3, l[1]);
+    l.splice(l.begin(), other);
+    ASSERT_TRUE(other.empty());
+    std::vector<int> expected{1, 2, 0, 3, 4};
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+}
+
+TEST(ArrayListLifetime, EraseRangeDestroys) {
+    Tracked::alive = 0;
+    cdt::ArrayList<Tracked, 10> l;
+    for (int i = 0; i < 6; i++) {
+        l.emplace_back(i);
+    }
+    l.erase(l.nth(1), l.nth(4));
+    ASSERT_EQ(3, Tracked::alive);
+    for (int i = 0; i < 7; i++) {
+        l.emplace_back(i);
+    }
+    ASSERT_EQ(10, Tracked::alive);
+    ASSERT_THROW(l.emplace_back(0), std::length_error);
+}
+
+/* ------------------------------------------------------------- */
+TEST(ArrayListOperations, Sort) {
+    cdt::ArrayList<int, 100> l;
+    std::vector<int> v;
+    for (int i = 0; i < 97; i++) {
+        v.push_back((i * 37) % 23);
+    }
+    l.assign(v.begin(), v.end());
+    l.sort();
+    std::sort(v.begin(), v.end());
+    ASSERT_TRUE(std::equal(v.begin(), v.end(), l.begin()));
+    // Check the backward links as well
+    auto it = l.end();
+    for (auto rit = v.rbegin(); rit != v.rend(); ++rit) {
+        ASSERT_EQ(*rit, *(--it));
+    }
+    ASSERT_EQ(l.begin(), it);
+}
+
+TEST(ArrayListOperations, SortIsStableAndKeepsPayloads) {
+    typedef std::pair<int, int> Entry;
+    cdt::ArrayList<Entry, 10> l;
+    l.assign({{3, 0}, {1, 1}, {3, 2}, {2, 3}, {1, 4}});
+    const Entry* first = &l.front();
+    l.sort([](const Entry& a, const Entry& b) { return a.first < b.first; });
+    std::vector<Entry> expected{{1, 1}, {1, 4}, {2, 3}, {3, 0}, {3, 2}};
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+    ASSERT_EQ(3, first->first);
+    ASSERT_EQ(0, first->second);
+}
+
+TEST(ArrayListOperations, SortThrowingCompare) {
+    cdt::ArrayList<int, 10> l;
+    l.assign({8, 7, 6, 5, 4, 3, 2, 1});
+    int calls = 0;
+    ASSERT_THROW(l.sort([&calls](int a, int b) {
+        if (++calls == 6) {
+            throw std::runtime_error("");
+        }
+        return a < b;
+    }),
+                 std::runtime_error);
+    // All elements are still linked in both directions
+    std::vector<int> forward(l.begin(), l.end());
+    std::vector<int> backward;
+    for (auto it = l.end(); it != l.begin();) {
+        backward.push_back(*(--it));
+    }
+    ASSERT_EQ(8, forward.size());
+    ASSERT_TRUE(std::equal(forward.rbegin(), forward.rend(), backward.begin()));
+    std::sort(forward.begin(), forward.end());
+    ASSERT_EQ(std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8}), forward);
+    l.sort();
+    ASSERT_TRUE(std::is_sorted(l.begin(), l.end()));
+}
+
+TEST(ArrayListOperations, Merge) {
+    cdt::ArrayList<int, 10> l;
+    cdt::ArrayList<int, 10> other;
+    l.assign({1, 3, 5, 7});
+    other.assign({0, 3, 4, 8, 9});
+    l.merge(other);
+    ASSERT_TRUE(other.empty());
+    std::vector<int> expected{0, 1, 3, 3, 4, 5, 7, 8, 9};
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+    other.assign({1, 2});
+    ASSERT_THROW(l.merge(other), std::length_error);
+    ASSERT_EQ(2, other.size());
+}
+
+TEST(ArrayListOperations, MergeThrowingCompare) {
+    cdt::ArrayList<int, 10> l;
+    cdt::ArrayList<int, 10> other;
+    l.assign({1, 3, 5, 7});
+    other.assign({0, 2, 4, 6});
+    ASSERT_THROW(l.merge(other,
+                         [](int a, int b) {
+                             if (a == 4) {
+                                 throw std::runtime_error("");
+                             }
+                             return a < b;
+                         }),
+                 std::runtime_error);
+    // Merged elements are only held by this list, the others stay in other
+    std::vector<int> expected{0, 1, 2, 3, 5, 7};
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+    ASSERT_EQ(expected.size(), l.size());
+    ASSERT_EQ(2, other.size());
+    ASSERT_EQ(4, other.front());
+    ASSERT_EQ(6, other.back());
+}
+
+TEST(ArrayListOperations, Unique) {
+    cdt::ArrayList<int, 10> l;
+    l.assign({1, 1, 2, 3, 3, 3, 1, 4, 4});
+    ASSERT_EQ(4, l.unique());
+    std::vector<int> expected{1, 2, 3, 1, 4};
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+    ASSERT_EQ(4, l.back());
+    ASSERT_EQ(1, *(--(--l.end())));
+    l.insert(l.end(), 5, 0);
+    ASSERT_EQ(10, l.size());
+}
+
+TEST(ArrayListOperations, UniqueThrowingPredicate) {
+    cdt::ArrayList<int, 10> l;
+    l.assign({1, 1, 2, 2, 3, 3, 4, 4});
+    ASSERT_THROW(l.unique([](int a, int b) {
+        if (a == 3) {
+            throw std::runtime_error("");
+        }
+        return a == b;
+    }),
+                 std::runtime_error);
+    // Duplicates found before the exception are erased, the rest stays untouched
+    std::vector<int> expected{1, 2, 3, 3, 4, 4};
+    ASSERT_EQ(expected.size(), l.size());
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+    auto it = l.end();
+    for (auto rit = expected.rbegin(); rit != expected.rend(); ++rit) {
+        ASSERT_EQ(*rit, *(--it));
+    }
+    ASSERT_EQ(l.begin(), it);
+    // The erased slots are available again
+    l.insert(l.end(), 4, 0);
+    ASSERT_EQ(10, l.size());
+}
+
+TEST(ArrayListOperations, RemoveIf) {
+    cdt::ArrayList<int, 10> l;
+    l.assign({1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+    ASSERT_EQ(5, l.remove_if([](int x) { return x % 2 == 0; }));
+    std::vector<int> expected{1, 3, 5, 7, 9};
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+    ASSERT_EQ(9, l.back());
+    ASSERT_EQ(7, *(--(--l.end())));
+    ASSERT_EQ(5, l[2]);
+    ASSERT_EQ(0, l.remove_if([](int x) { return x > 100; }));
+    ASSERT_EQ(5, l.size());
+    // All freed slots are available again
+    l.insert(l.begin(), 5, 0);
+    ASSERT_EQ(10, l.size());
+    ASSERT_EQ(10, l.remove_if([](int) { return true; }));
+    ASSERT_TRUE(l.empty());
+    ASSERT_EQ(l.begin(), l.end());
+}
+
+TEST(ArrayListOperations, Remove) {
+    cdt::ArrayList<int, 10> l;
+    ASSERT_EQ(0, l.remove(1));
+    l.assign({1, 1, 2, 1, 3, 1});
+    ASSERT_EQ(4, l.remove(1));
+    std::vector<int> expected{2, 3};
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+    ASSERT_EQ(2, l.front());
+    ASSERT_EQ(3, l.back());
+}
+
+TEST(ArrayListOperations, RemoveIfThrowingPredicate) {
+    cdt::ArrayList<int, 10> l;
+    l.assign({1, 2, 3, 4, 5, 6});
+    ASSERT_THROW(l.remove_if([](int x) {
+        if (x == 5) {
+            throw std::runtime_error("");
+        }
+        return x % 2 == 0;
+    }),
+                 std::runtime_error);
+    // Elements visited before the exception are erased, the rest stays untouched
+    std::vector<int> expected{1, 3, 5, 6};
+    ASSERT_EQ(expected.size(), l.size());
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+    ASSERT_EQ(6, l.back());
+    ASSERT_EQ(5, *(--(--l.end())));
+    ASSERT_EQ(3, l[1]);
+}
+
+TEST(ArrayListLifetime, RemoveIfDestroys) {
+    Tracked::alive = 0;
+    {
+        cdt::ArrayList<Tracked, 10> l;
+        for (int i = 0; i < 10; i++) {
+            l.emplace_back(i);
+        }
+        ASSERT_EQ(4, l.remove_if([](const Tracked& t) { return t.value % 3 == 0; }));
+        ASSERT_EQ(6, Tracked::alive);
+    }
+    ASSERT_EQ(0, Tracked::alive);
+}
+
+TEST_F(FullFixture, Reverse) {
+    l.reverse();
+    for (size_t i = 0; i < capacity; i++) {
+        ASSERT_EQ(capacity - 1 - i, l[i]);
+    }
+    ASSERT_EQ(0, l.back());
+    l.reverse();
+    ASSERT_EQ(0, l.front());
+    ASSERT_EQ(capacity - 1, l.back());
+}
+
+/* ------------------------------------------------------------- */
+TEST(ArrayListCompact, ContiguousAfterAppending) {
+    cdt::ArrayList<int, 10, cdt::SplitLayout> l;
+    ASSERT_TRUE(l.is_contiguous());
+    l.assign({0, 1, 2, 3});
+    ASSERT_TRUE(l.is_contiguous());
+    const int* d = l.contiguous_data();
+    ASSERT_NE(nullptr, d);
+    ASSERT_TRUE(std::equal(l.begin(), l.end(), d));
+    l.push_front(5);
+    ASSERT_FALSE(l.is_contiguous());
+    ASSERT_EQ(nullptr, l.contiguous_data());
+}
+
+TEST(ArrayListCompact, CompactAfterChurn) {
+    cdt::ArrayList<int, 20, cdt::SplitLayout> l;
+    std::vector<int> expected;
+    for (int i = 0; i < 20; i++) {
+        if (i % 3) {
+            l.push_front(i);
+        } else {
+            l.push_back(i);
+        }
+    }
+    l.erase(l.nth(4), l.nth(7));
+    l.erase(l.nth(10));
+    l.reverse();
+    l.push_front(100);
+    expected.assign(l.begin(), l.end());
+    ASSERT_FALSE(l.is_contiguous());
+
+    l.compact();
+    ASSERT_TRUE(l.is_contiguous());
+    ASSERT_EQ(expected.size(), l.size());
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.contiguous_data()));
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+    auto it = l.end();
+    for (auto rit = expected.rbegin(); rit != expected.rend(); ++rit) {
+        ASSERT_EQ(*rit, *(--it));
+    }
+
+    // Refill up to capacity, appending keeps the list contiguous
+    while (l.size() < l.max_size()) {
+        l.push_back(-1);
+    }
+    ASSERT_TRUE(l.is_contiguous());
+    ASSERT_THROW(l.push_back(0), std::length_error);
+    ASSERT_EQ(-1, l.contiguous_data()[l.size() - 1]);
+}
+
+TEST(ArrayListCompact, CompactKeepsPayloadsAlive) {
+    Tracked::alive = 0;
+    {
+        cdt::ArrayList<Tracked, 10> l;
+        for (int i = 0; i < 8; i++) {
+            l.emplace_front(i);
+        }
+        l.erase(l.nth(2));
+        l.erase(l.nth(5));
+        l.emplace_back(42);
+        l.compact();
+        ASSERT_EQ(7, Tracked::alive);
+        std::vector<int> expected{7, 6, 4, 3, 2, 0, 42};
+        size_t i = 0;
+        for (auto it = l.begin(); it != l.end(); ++it) {
+            ASSERT_EQ(expected[i++], it->value);
+        }
+        l.emplace_back(1);
+        l.emplace_front(2);
+        l.emplace_back(3);
+        ASSERT_EQ(10, Tracked::alive);
+    }
+    ASSERT_EQ(0, Tracked::alive);
+}
+
+/* ------------------------------------------------------------- */
+TEST(ArrayListCopy, KeepsSlotLayout) {
+    cdt::ArrayList<int, 20, cdt::SplitLayout> l;
+    for (int i = 0; i < 10; i++) {
+        l.push_front(i);
+    }
+    l.erase(l.nth(2));
+    cdt::ArrayList<int, 20, cdt::SplitLayout> copy(l);
+    ASSERT_TRUE(std::equal(l.begin(), l.end(), copy.begin()));
+    ASSERT_EQ(l.size(), copy.size());
+    ASSERT_FALSE(copy.is_contiguous());
+    // The free list is taken over as well
+    while (copy.size() < copy.max_size()) {
+        copy.push_back(-1);
+    }
+    ASSERT_THROW(copy.push_back(0), std::length_error);
+    ASSERT_EQ(l.size(), std::count_if(copy.begin(), copy.end(), [](int x) { return x >= 0; }));
+}
+
+TEST(ArrayListCopy, PacksSparseList) {
+    cdt::ArrayList<int, 20, cdt::SplitLayout> l;
+    for (int i = 0; i < 20; i++) {
+        l.push_back(i);
+    }
+    l.erase(l.nth(1), l.nth(17));
+    cdt::ArrayList<int, 20, cdt::SplitLayout> copy;
+    copy = l;
+    ASSERT_EQ((std::vector<int>{0, 17, 18, 19}), std::vector<int>(copy.begin(), copy.end()));
+    ASSERT_TRUE(copy.is_contiguous());
+}
+
+TEST(ArrayListCopy, AssignCompacted) {
+    cdt::ArrayList<int, 20, cdt::SplitLayout> l;
+    for (int i = 0; i < 10; i++) {
+        l.push_front(i);
+    }
+    cdt::ArrayList<int, 20, cdt::SplitLayout> copy;
+    copy.push_back(99);
+    copy.assign_compacted(l);
+    ASSERT_TRUE(copy.is_contiguous());
+    ASSERT_TRUE(std::equal(l.begin(), l.end(), copy.contiguous_data()));
+    ASSERT_EQ(l.size(), copy.size());
+    l.assign_compacted(l);
+    ASSERT_TRUE(l.is_contiguous());
+    ASSERT_TRUE(std::equal(copy.begin(), copy.end(), l.begin()));
+}
+
+TEST(ArrayListCopy, Move) {
+    cdt::ArrayList<int, 20> l;
+    l.assign({3, 1, 2});
+    l.erase(l.begin());
+    cdt::ArrayList<int, 20> moved(std::move(l));
+    ASSERT_TRUE(l.empty());
+    ASSERT_EQ((std::vector<int>{1, 2}), std::vector<int>(moved.begin(), moved.end()));
+    l = std::move(moved);
+    ASSERT_TRUE(moved.empty());
+    ASSERT_EQ(2, l.back());
+}
+
+TEST(ArrayListCopy, NonTrivialElements) {
+    cdt::ArrayList<std::string, 8> l;
+    l.assign({"a", "b", "a long string, which does not fit into the small buffer", "d"});
+    l.erase(l.begin());
+    cdt::ArrayList<std::string, 8> copy(l);
+    ASSERT_TRUE(copy.is_contiguous());
+    ASSERT_TRUE(std::equal(l.begin(), l.end(), copy.begin()));
+    cdt::ArrayList<std::string, 8> moved(std::move(copy));
+    ASSERT_TRUE(copy.empty());
+    ASSERT_EQ(3, moved.size());
+    ASSERT_EQ("d", moved.back());
+}
+
+TEST(ArrayListSwap, DifferentSizes) {
+    cdt::ArrayList<int, 10> a;
+    cdt::ArrayList<int, 10> b;
+    a.assign({1, 2, 3, 4, 5, 6});
+    b.assign({7, 8});
+    b.push_front(9);
+    swap(a, b);
+    ASSERT_EQ((std::vector<int>{9, 7, 8}), std::vector<int>(a.begin(), a.end()));
+    ASSERT_EQ((std::vector<int>{1, 2, 3, 4, 5, 6}), std::vector<int>(b.begin(), b.end()));
+    a.swap(b);
+    ASSERT_EQ((std::vector<int>{1, 2, 3, 4, 5, 6}), std::vector<int>(a.begin(), a.end()));
+    ASSERT_EQ((std::vector<int>{9, 7, 8}), std::vector<int>(b.begin(), b.end()));
+    a.swap(a);
+    ASSERT_EQ(6, a.size());
+}
+
+TEST(ArrayListSwap, Empty) {
+    cdt::ArrayList<int, 10> a;
+    cdt::ArrayList<int, 10> b;
+    b.assign({1, 2});
+    a.swap(b);
+    ASSERT_TRUE(b.empty());
+    ASSERT_EQ(2, a.size());
+    a.swap(b);
+    ASSERT_TRUE(a.empty());
+    ASSERT_EQ(1, b.front());
+}
+
+TEST(ArrayListSwap, Lifetime) {
+    Tracked::alive = 0;
+    {
+        cdt::ArrayList<Tracked, 10> a;
+        cdt::ArrayList<Tracked, 10> b;
+        for (int i = 0; i < 7; i++) {
+            a.emplace_back(i);
+        }
+        b.emplace_back(10);
+        a.swap(b);
+        ASSERT_EQ(8, Tracked::alive);
+        ASSERT_EQ(1, a.size());
+        ASSERT_EQ(10, a.front().value);
+        ASSERT_EQ(7, b.size());
+        ASSERT_EQ(6, b.back().value);
+    }
+    ASSERT_EQ(0, Tracked::alive);
+}
+
+/* ------------------------------------------------------------- */
+/// Elements visited by for_each_unordered() in the slots first..last-1, sorted for comparison
+template <typename _List>
+std::vector<int> visited(const _List& l, size_t first = 0, size_t last = size_t(-1)) {
+    std::vector<int> result;
+    l.for_each_unordered(first, last, [&result](const int& x) { result.push_back(x); });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+template <typename _List>
+std::vector<int> sorted(const _List& l) {
+    std::vector<int> result(l.begin(), l.end());
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+TEST(ArrayListUnordered, VisitsSlotsInOrder) {
+    cdt::ArrayList<int, 300, cdt::SplitLayout> l;
+    for (int i = 0; i < 300; i++) {
+        if (i % 2) {
+            l.push_front(i);
+        } else {
+            l.push_back(i);
+        }
+    }
+    l.remove_if([](int x) { return x % 7 == 0; });
+    l.erase(l.nth(10), l.nth(100));
+    l.push_back(1000); // Recycles a slot
+    std::vector<const int*> addresses;
+    l.for_each_unordered([&addresses](const int& x) { addresses.push_back(&x); });
+    ASSERT_EQ(l.size(), addresses.size());
+    ASSERT_TRUE(std::is_sorted(addresses.begin(), addresses.end()));
+    ASSERT_EQ(sorted(l), visited(l));
+}
+
+TEST(ArrayListUnordered, SlotRanges) {
+    cdt::ArrayList<int, 200> l;
+    for (int i = 0; i < 150; i++) {
+        l.push_back(i);
+    }
+    l.remove_if([](int x) { return x % 5 == 1; });
+    ASSERT_EQ(150, l.slot_count());
+    std::vector<int> parts;
+    const size_t bounds[] = {0, 1, 37, 64, 65, 128, 130, 150};
+    for (size_t k = 0; k + 1 < sizeof(bounds) / sizeof(bounds[0]); k++) {
+        const std::vector<int> part = visited(l, bounds[k], bounds[k + 1]);
+        parts.insert(parts.end(), part.begin(), part.end());
+    }
+    ASSERT_EQ(sorted(l), parts);
+    ASSERT_EQ((std::vector<int>{2, 3, 4}), visited(l, 2, 5));
+    ASSERT_TRUE(visited(l, 150, 1000).empty());
+    ASSERT_TRUE(visited(l, 40, 20).empty());
+}
+
+TEST(ArrayListUnordered, Modify) {
+    cdt::ArrayList<int, 100> l;
+    for (int i = 0; i < 100; i++) {
+        l.push_front(i);
+    }
+    l.erase(l.nth(50));
+    l.for_each_unordered([](int& x) { x *= 2; });
+    int expected = 99;
+    for (int x : l) {
+        ASSERT_EQ(2 * expected, x);
+        expected -= expected == 50 ? 2 : 1;
+    }
+}
+
+TEST(ArrayListUnordered, FollowsStructuralChanges) {
+    typedef cdt::ArrayList<int, 130, cdt::SplitLayout> List;
+    List l;
+    for (int i = 0; i < 130; i++) {
+        l.push_back(i);
+    }
+    l.clear();
+    ASSERT_TRUE(visited(l).empty());
+    for (int i = 0; i < 70; i++) {
+        l.push_front(i);
+    }
+    l.erase(l.nth(3), l.nth(60));
+    ASSERT_EQ(sorted(l), visited(l)); // Bits of the cleared elements are gone
+    l.compact();
+    ASSERT_EQ(sorted(l), visited(l));
+    l.push_back(100);
+    l.erase(l.begin());
+
+    List copy(l); // Raw copy of a dense list
+    ASSERT_EQ(sorted(l), visited(copy));
+    List other;
+    for (int i = 0; i < 120; i++) {
+        other.push_back(-i);
+    }
+    other.erase(other.nth(5));
+    l.swap(other);
+    ASSERT_EQ(sorted(copy), visited(other));
+    ASSERT_EQ(sorted(l), visited(l));
+    l.erase(l.nth(1), l.nth(110));
+    List packed(l); // Packed copy of a sparse list
+    ASSERT_EQ(sorted(l), visited(packed));
+}
@@ -0,0 +1,54 @@
+#define CDT_CHECK_POLICY CDT_UNCHECKED
+#include <array_list/arraylist.hpp>
+#include <array_list/fixedvector.hpp>
+#include "gtest/gtest.h"
+#include <utility>
+
+// Without checks, element access can not throw
+static_assert(noexcept(std::declval<cdt::ArrayList<int, 5>&>()[0]), "Unchecked subscript has to be noexcept.");
+static_assert(noexcept(*std::declval<cdt::ArrayList<int, 5>::iterator&>()), "Unchecked dereference has to be noexcept.");
+static_assert(noexcept(std::declval<cdt::FixedVector<int, 5>&>()[0]), "Unchecked subscript has to be noexcept.");
+// at() checks independent of the policy
+static_assert(!noexcept(std::declval<cdt::ArrayList<int, 5>&>().at(0)), "at() has to be checked.");
+static_assert(!noexcept(std::declval<cdt::FixedVector<int, 5>&>().at(0)), "at() has to be checked.");
+
+/* ------------------------------------------------------------- */
+TEST(UncheckedArrayList, AccessWithinBounds) {
+    cdt::ArrayList<int, 5> l;
+    for (int i = 0; i < 5; i++) {
+        l.push_back(i);
+    }
+    for (int i = 0; i < 5; i++) {
+        ASSERT_EQ(i, l[i]);
+    }
+    ASSERT_EQ(0, *l.begin());
+    ASSERT_EQ(4, l.back());
+    l.erase(l.nth(2));
+    ASSERT_EQ(3, l[2]);
+}
+
+TEST(UncheckedArrayList, AtStillThrows) {
+    cdt::ArrayList<int, 5> l;
+    l.push_back(1);
+    ASSERT_EQ(1, l.at(0));
+    ASSERT_THROW(l.at(1), std::out_of_range);
+}
+
+TEST(UncheckedFixedVector, AccessWithinBounds) {
+    cdt::FixedVector<int, 5> l;
+    for (int i = 0; i < 5; i++) {
+        l.push_back(i);
+    }
+    for (int i = 0; i < 5; i++) {
+        ASSERT_EQ(i, l[i]);
+    }
+    l.pop_back();
+    ASSERT_EQ(3, l.back());
+}
+
+TEST(UncheckedFixedVector, AtStillThrows) {
+    cdt::FixedVector<int, 5> l;
+    l.push_back(1);
+    ASSERT_EQ(1, l.at(0));
+    ASSERT_THROW(l.at(1), std::out_of_range);
+}
@@ -0,0 +1,74 @@
+#include <array_list/arraylist.hpp>
+#include <array_list/fixedvector.hpp>
+#include "gtest/gtest.h"
+
+#if CDT_HAS_CONSTEXPR_CONTAINERS
+namespace {
+struct Route {
+    int destination;
+    int hop;
+};
+
+/// Lookup tables built entirely at compile time
+constexpr auto squares = [] {
+    cdt::FixedVector<int, 16> v;
+    for (int i = 0; i < 10; i++) {
+        v.push_back(i * i);
+    }
+    v.erase(v.begin()); // The last element takes the place of the first
+    return v;
+}();
+
+constexpr auto routes = [] {
+    cdt::FixedVector<Route, 8> v;
+    v.emplace_back(Route{1, 10});
+    v.emplace_back(Route{2, 20});
+    return v;
+}();
+
+constexpr auto sorted = [] {
+    cdt::ArrayList<int, 8> l;
+    l.assign({5, 3, 7, 1});
+    l.push_front(9);
+    l.erase(l.nth(2));
+    l.sort();
+    return l;
+}();
+
+constexpr int sum(const cdt::ArrayList<int, 8>& l) {
+    int result = 0;
+    for (int x : l) {
+        result += x;
+    }
+    return result;
+}
+
+constexpr int unordered_sum(const cdt::ArrayList<int, 8>& l) {
+    int result = 0;
+    l.for_each_unordered([&result](int x) { result += x; });
+    return result;
+}
+} // namespace
+
+static_assert(squares.size() == 9, "Table is built at compile time.");
+static_assert(squares[0] == 81 && squares[1] == 1 && squares.back() == 64, "Erase moves the last element.");
+static_assert(squares.contains(49) && !squares.contains(50), "Lookup works in constant expressions.");
+static_assert(squares.count(4) == 1, "Lookup works in constant expressions.");
+static_assert(routes.at(1).hop == 20, "Aggregates are emplaced at compile time.");
+static_assert(sorted.size() == 4, "Table is built at compile time.");
+static_assert(sorted[0] == 1 && sorted[1] == 5 && sorted[3] == 9, "Sorted at compile time.");
+static_assert(sum(sorted) == 22, "Iteration works in constant expressions.");
+static_assert(unordered_sum(sorted) == 22, "Slot order traversal works in constant expressions.");
+
+TEST(Constexpr, TablesUsableAtRuntime) {
+    ASSERT_EQ(81, squares.front());
+    ASSERT_EQ(squares.begin() + 4, squares.find(16));
+    ASSERT_EQ(10, routes.front().hop);
+    ASSERT_EQ(1, sorted.front());
+    ASSERT_EQ(9, sorted.back());
+}
+#else
+TEST(Constexpr, RequiresCpp20) {
+    GTEST_SKIP() << "Constant expression support needs C++20.";
+}
+#endif
@@ -0,0 +1,294 @@
+#include <array_list/fixedhashmap.hpp>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "gtest/gtest.h"
+#include "tracked.hpp"
+
+typedef cdt::FixedHashMap<int, int, 100> Map;
+
+// Set up fixtures
+class FullHashmap : public ::testing::Test {
+public:
+    FullHashmap() {
+        for (int i = 0; i < static_cast<int>(capacity); i++) {
+            m.insert(std::make_pair(i, 10 * i));
+        }
+    };
+    static constexpr size_t capacity = 100;
+    Map m;
+};
+constexpr size_t FullHashmap::capacity;
+
+/// Maps all keys onto a few hashes, so lookups have to compare many keys
+struct CollidingHash {
+    size_t operator()(int key) const {
+        return key % 3;
+    }
+};
+
+/* ------------------------------------------------------------- */
+TEST(Hashmap, Empty) {
+    Map m;
+    ASSERT_TRUE(m.empty());
+    ASSERT_EQ(0, m.size());
+    ASSERT_EQ(100, m.capacity());
+    ASSERT_TRUE(m.begin() == m.end());
+    ASSERT_TRUE(m.find(1) == m.end());
+    ASSERT_FALSE(m.contains(1));
+    // Power of two slots, with room for all elements at a load of 7/8
+    ASSERT_EQ(128, m.slot_count());
+    ASSERT_GE(m.slot_count() * 7 / 8, m.capacity());
+    ASSERT_EQ(16, (cdt::FixedHashMap<int, int, 1>::SLOTS));
+    ASSERT_EQ(32, (cdt::FixedHashMap<int, int, 15>::SLOTS));
+}
+
+TEST(Hashmap, InsertFind) {
+    Map m;
+    auto result = m.insert(std::make_pair(3, 30));
+    ASSERT_TRUE(result.second);
+    ASSERT_EQ(3, result.first->first);
+    ASSERT_EQ(30, result.first->second);
+    result = m.insert(std::make_pair(3, 31));
+    ASSERT_FALSE(result.second); // Existing keys are kept
+    ASSERT_EQ(30, result.first->second);
+    ASSERT_EQ(1, m.size());
+    ASSERT_EQ(30, m.find(3)->second);
+    ASSERT_EQ(1, m.count(3));
+    ASSERT_EQ(0, m.count(4));
+}
+
+TEST(Hashmap, Access) {
+    Map m;
+    m[5] = 50;
+    ASSERT_EQ(50, m.at(5));
+    ASSERT_EQ(0, m[6]); // Value initialized
+    ASSERT_EQ(2, m.size());
+    ASSERT_THROW(m.at(7), std::out_of_range);
+    const Map& c = m;
+    ASSERT_EQ(50, c.at(5));
+    ASSERT_THROW(c.at(7), std::out_of_range);
+}
+
+TEST(Hashmap, EmplaceVariants) {
+    Map m;
+    ASSERT_TRUE(m.try_emplace(1, 10).second);
+    ASSERT_FALSE(m.try_emplace(1, 11).second);
+    ASSERT_EQ(10, m.at(1));
+    ASSERT_FALSE(m.insert_or_assign(1, 12).second);
+    ASSERT_EQ(12, m.at(1));
+    ASSERT_TRUE(m.insert_or_assign(2, 20).second);
+    ASSERT_TRUE(m.emplace(3, 30).second);
+    ASSERT_FALSE(m.emplace(3, 31).second);
+    ASSERT_EQ(30, m.at(3));
+}
+
+TEST(Hashmap, InitializerList) {
+    Map m{{1, 2}, {3, 4}, {1, 5}};
+    ASSERT_EQ(2, m.size());
+    ASSERT_EQ(2, m.at(1));
+    ASSERT_EQ(4, m.at(3));
+}
+
+TEST_F(FullHashmap, InsertIntoFull) {
+    ASSERT_EQ(capacity, m.size());
+    ASSERT_THROW(m.insert(std::make_pair(1000, 0)), std::length_error);
+    ASSERT_FALSE(m.insert(std::make_pair(5, 0)).second); // Present keys are still found
+    ASSERT_EQ(capacity, m.size());
+}
+
+TEST_F(FullHashmap, Iterate) {
+    std::vector<int> keys;
+    for (const auto& x : m) {
+        ASSERT_EQ(10 * x.first, x.second);
+        keys.push_back(x.first);
+    }
+    std::sort(keys.begin(), keys.end());
+    ASSERT_EQ(capacity, keys.size());
+    for (int i = 0; i < static_cast<int>(capacity); i++) {
+        ASSERT_EQ(i, keys[i]);
+    }
+    for (auto& x : m) {
+        x.second = -x.first;
+    }
+    ASSERT_EQ(-7, m.at(7));
+}
+
+TEST_F(FullHashmap, Erase) {
+    ASSERT_EQ(1, m.erase(10));
+    ASSERT_EQ(0, m.erase(10));
+    ASSERT_FALSE(m.contains(10));
+    ASSERT_EQ(capacity - 1, m.size());
+    // Erasing through iterators visits every remaining element once
+    size_t erased = 0;
+    for (auto it = m.begin(); it != m.end();) {
+        if (it->first % 2) {
+            it = m.erase(it);
+            ++erased;
+        } else {
+            ++it;
+        }
+    }
+    ASSERT_EQ(capacity / 2, erased);
+    for (int i = 0; i < static_cast<int>(capacity); i++) {
+        ASSERT_EQ(i % 2 == 0 && i != 10, m.contains(i));
+    }
+    ASSERT_THROW(m.erase(m.end()), std::out_of_range);
+}
+
+TEST_F(FullHashmap, ChurnAtCapacity) {
+    // Keeps the table full while replacing keys, so DELETED markers pile up and have to be cleaned up
+    for (int round = 0; round < 50; round++) {
+        for (int i = 0; i < static_cast<int>(capacity); i++) {
+            const int old_key = round * 1000 + i;
+            const int new_key = (round + 1) * 1000 + i;
+            if (round == 0) {
+                ASSERT_EQ(1, m.erase(i));
+            } else {
+                ASSERT_EQ(1, m.erase(old_key));
+            }
+            ASSERT_TRUE(m.insert(std::make_pair(new_key, i)).second);
+        }
+        ASSERT_EQ(capacity, m.size());
+    }
+    for (int i = 0; i < static_cast<int>(capacity); i++) {
+        ASSERT_EQ(i, m.at(50 * 1000 + i));
+    }
+}
+
+TEST_F(FullHashmap, Clear) {
+    m.clear();
+    ASSERT_TRUE(m.empty());
+    ASSERT_TRUE(m.begin() == m.end());
+    ASSERT_FALSE(m.contains(1));
+    m[1] = 2;
+    ASSERT_EQ(2, m.at(1));
+}
+
+TEST_F(FullHashmap, CopyAndMove) {
+    m.erase(3);
+    Map copy(m);
+    ASSERT_EQ(m.size(), copy.size());
+    ASSERT_FALSE(copy.contains(3));
+    ASSERT_EQ(40, copy.at(4));
+    copy[4] = 0; // Copies are independent
+    ASSERT_EQ(40, m.at(4));
+
+    Map moved(std::move(copy));
+    ASSERT_TRUE(copy.empty());
+    ASSERT_EQ(0, moved.at(4));
+    Map assigned;
+    assigned[1000] = 1;
+    assigned = moved;
+    ASSERT_FALSE(assigned.contains(1000));
+    ASSERT_EQ(m.size(), assigned.size());
+}
+
+TEST_F(FullHashmap, RawCopy) {
+    // Without pointers, a map of trivially copyable types stays valid at any address
+    std::unique_ptr<Map> raw(new Map());
+    std::memcpy(static_cast<void*>(raw.get()), &m, sizeof(Map));
+    for (int i = 0; i < static_cast<int>(capacity); i++) {
+        ASSERT_EQ(10 * i, raw->at(i));
+    }
+    raw->erase(5);
+    ASSERT_TRUE(m.contains(5));
+}
+
+TEST(Hashmap, Colliding) {
+    cdt::FixedHashMap<int, int, 200, CollidingHash> m;
+    for (int i = 0; i < 200; i++) {
+        m[i] = i;
+    }
+    for (int i = 0; i < 200; i += 2) {
+        m.erase(i);
+    }
+    for (int i = 0; i < 200; i++) {
+        ASSERT_EQ(i % 2 == 1, m.contains(i));
+    }
+    for (int i = 200; i < 300; i++) {
+        m[i] = i;
+    }
+    ASSERT_EQ(200, m.size());
+    for (int i = 1; i < 300; i++) {
+        ASSERT_EQ(i % 2 == 1 || i >= 200, m.contains(i));
+    }
+}
+
+TEST(Hashmap, RandomChurnAtCapacity) {
+    // 112 elements fill 7/8 of the slots, so full groups leave DELETED markers, which are cleaned up in place
+    cdt::FixedHashMap<int, int, 112> m;
+    std::unordered_map<int, int> expected;
+    std::mt19937 rng(3);
+    for (int i = 0; i < 112; i++) {
+        m[i] = i;
+        expected[i] = i;
+    }
+    ASSERT_EQ(128, m.slot_count());
+    for (int op = 0; op < 20000; op++) {
+        auto it = expected.begin();
+        std::advance(it, rng() % expected.size());
+        ASSERT_EQ(1, m.erase(it->first));
+        expected.erase(it);
+        const int key = static_cast<int>(rng());
+        ASSERT_EQ(expected.emplace(key, op).second, m.insert(std::make_pair(key, op)).second);
+    }
+    for (const auto& x : expected) {
+        ASSERT_EQ(x.second, m.at(x.first));
+    }
+}
+
+TEST(Hashmap, NonTrivialElements) {
+    Tracked::alive = 0;
+    {
+        cdt::FixedHashMap<std::string, Tracked, 40> m;
+        for (int i = 0; i < 40; i++) {
+            m.try_emplace(std::to_string(i), i);
+        }
+        ASSERT_EQ(40, Tracked::alive);
+        for (int round = 0; round < 10; round++) {
+            for (int i = 0; i < 40; i += 3) {
+                m.erase(std::to_string(i));
+                m.try_emplace(std::to_string(i), i);
+            }
+        }
+        ASSERT_EQ(40, Tracked::alive);
+        m.erase("7");
+        ASSERT_EQ(39, Tracked::alive);
+        cdt::FixedHashMap<std::string, Tracked, 40> copy(m);
+        ASSERT_EQ(78, Tracked::alive);
+        ASSERT_EQ(12, copy.at("12").value);
+        copy.clear();
+        ASSERT_EQ(39, Tracked::alive);
+    }
+    ASSERT_EQ(0, Tracked::alive);
+}
+
+TEST(Hashmap, RandomAgainstUnorderedMap) {
+    cdt::FixedHashMap<int, int, 500> m;
+    std::unordered_map<int, int> expected;
+    std::mt19937 rng(7);
+    for (int op = 0; op < 200000; op++) {
+        const int key = rng() % 1000;
+        if (rng() % 2 && expected.size() < 500) {
+            ASSERT_EQ(expected.emplace(key, op).second, m.insert(std::make_pair(key, op)).second);
+        } else {
+            ASSERT_EQ(expected.erase(key), m.erase(key));
+        }
+        ASSERT_EQ(expected.size(), m.size());
+    }
+    for (const auto& x : expected) {
+        ASSERT_EQ(x.second, m.at(x.first));
+    }
+    size_t n = 0;
+    for (const auto& x : m) {
+        ASSERT_EQ(expected.at(x.first), x.second);
+        ++n;
+    }
+    ASSERT_EQ(expected.size(), n);
+}
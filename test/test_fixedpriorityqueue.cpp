@@ -0,0 +1,370 @@
+#include <array_list/fixedpriorityqueue.hpp>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "tracked.hpp"
+
+// Set up fixtures
+class EmptyQueue : public ::testing::Test {
+public:
+    EmptyQueue(){};
+    static constexpr size_t capacity = 5;
+    cdt::FixedPriorityQueue<int, capacity> q;
+};
+constexpr size_t EmptyQueue::capacity;
+
+class FullQueue : public ::testing::Test {
+public:
+    typedef cdt::FixedPriorityQueue<int, 20>::Handle Handle;
+    FullQueue() {
+        for (size_t i = 0; i < capacity; i++) {
+            handles.push_back(q.push((i * 7) % capacity)); // 0, 7, 14, 1, 8, ...
+        }
+    };
+    static constexpr size_t capacity = 20;
+    cdt::FixedPriorityQueue<int, capacity> q;
+    std::vector<Handle> handles;
+};
+constexpr size_t FullQueue::capacity;
+
+/// Whether no element has a higher priority than its parent
+template <typename _Queue>
+bool is_heap(const _Queue& q) {
+    auto v = q.begin();
+    for (size_t k = 1; k < q.size(); k++) {
+        if (q.value_comp()(v[(k - 1) / _Queue::ARITY], v[k])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Pop all elements
+template <typename _Queue>
+std::vector<typename _Queue::value_type> drain(_Queue& q) {
+    std::vector<typename _Queue::value_type> values;
+    while (!q.empty()) {
+        values.push_back(q.top());
+        q.pop();
+    }
+    return values;
+}
+
+/* ------------------------------------------------------------- */
+TEST_F(EmptyQueue, EmptySize) {
+    ASSERT_EQ(0, q.size());
+    ASSERT_TRUE(q.empty());
+    ASSERT_EQ(capacity, q.capacity());
+    ASSERT_EQ(q.begin(), q.end());
+    ASSERT_THROW(q.top(), std::out_of_range);
+    ASSERT_THROW(q.top_handle(), std::out_of_range);
+    ASSERT_THROW(q.pop(), std::out_of_range);
+}
+
+TEST_F(EmptyQueue, DefaultHandleIsStale) {
+    cdt::FixedPriorityQueue<int, capacity>::Handle h;
+    ASSERT_FALSE(q.contains(h));
+    ASSERT_EQ(nullptr, q.find(h));
+    ASSERT_FALSE(q.erase(h));
+    ASSERT_THROW(q.update(h, 1), std::out_of_range);
+    q.push(1);
+    ASSERT_FALSE(q.contains(h));
+}
+
+TEST_F(EmptyQueue, PushTop) {
+    auto a = q.push(3);
+    ASSERT_EQ(3, q.top());
+    ASSERT_EQ(a, q.top_handle());
+    auto b = q.emplace(5);
+    ASSERT_EQ(5, q.top());
+    ASSERT_EQ(b, q.top_handle());
+    q.push(4);
+    ASSERT_EQ(5, q.top());
+    ASSERT_EQ(3, q[a]);
+    ASSERT_EQ(5, q.at(b));
+    ASSERT_EQ(3, q.size());
+}
+
+TEST_F(FullQueue, InsertIntoFull) {
+    ASSERT_EQ(capacity, q.size());
+    ASSERT_THROW(q.push(1), std::length_error);
+    ASSERT_EQ(capacity, q.size());
+    ASSERT_TRUE(is_heap(q));
+}
+
+TEST_F(FullQueue, PopInOrder) {
+    ASSERT_TRUE(is_heap(q));
+    for (int i = capacity - 1; i >= 0; i--) {
+        ASSERT_EQ(i, q.top());
+        auto h = q.top_handle();
+        ASSERT_EQ(handles[(i * 3) % capacity], h); // 7 * 3 = 1 mod 20
+        q.pop();
+        ASSERT_FALSE(q.contains(h));
+        ASSERT_TRUE(is_heap(q));
+    }
+    ASSERT_TRUE(q.empty());
+}
+
+TEST_F(FullQueue, HandlesFollowElements) {
+    for (size_t i = 0; i < capacity; i++) {
+        ASSERT_EQ(static_cast<int>((i * 7) % capacity), q[handles[i]]);
+    }
+    for (auto it = q.begin(); it != q.end(); ++it) {
+        ASSERT_EQ(&*it, q.find(q.handle_of(it)));
+    }
+}
+
+TEST_F(FullQueue, Update) {
+    q.update(handles[0], 100); // Element 0 moves up to the top
+    ASSERT_EQ(100, q.top());
+    ASSERT_EQ(handles[0], q.top_handle());
+    ASSERT_TRUE(is_heap(q));
+    q.update(handles[0], -1); // And down to the bottom
+    ASSERT_EQ(-1, q[handles[0]]);
+    ASSERT_TRUE(is_heap(q));
+    q.update(handles[1], 7); // Unchanged
+    ASSERT_TRUE(is_heap(q));
+    std::vector<int> values = drain(q);
+    ASSERT_EQ(-1, values.back());
+    ASSERT_TRUE(std::is_sorted(values.rbegin(), values.rend()));
+}
+
+TEST_F(FullQueue, DecreaseKey) {
+    q.decrease_key(handles[3], 50); // handles[3] holds 1
+    ASSERT_EQ(50, q.top());
+    ASSERT_EQ(handles[3], q.top_handle());
+    q.decrease_key(handles[3], 50);
+    ASSERT_TRUE(is_heap(q));
+    ASSERT_THROW(q.decrease_key(handles[3], 49), std::invalid_argument);
+    ASSERT_EQ(50, q[handles[3]]);
+    ASSERT_TRUE(is_heap(q));
+}
+
+TEST(FixedPriorityQueue, MinQueue) {
+    cdt::FixedPriorityQueue<int, 16, std::greater<int>> q;
+    std::vector<cdt::FixedPriorityQueue<int, 16, std::greater<int>>::Handle> handles;
+    for (int deadline : {40, 10, 30, 20}) {
+        handles.push_back(q.push(deadline));
+    }
+    ASSERT_EQ(10, q.top());
+    q.decrease_key(handles[0], 5); // An earlier deadline moves to the top
+    ASSERT_EQ(5, q.top());
+    ASSERT_THROW(q.decrease_key(handles[2], 35), std::invalid_argument);
+    q.update(handles[0], 25); // Rescheduled to a later deadline
+    ASSERT_EQ((std::vector<int>{10, 20, 25, 30}), drain(q));
+}
+
+TEST_F(FullQueue, EraseMakesHandleStale) {
+    ASSERT_TRUE(q.erase(handles[1]));
+    ASSERT_EQ(capacity - 1, q.size());
+    ASSERT_TRUE(is_heap(q));
+    ASSERT_FALSE(q.contains(handles[1]));
+    ASSERT_EQ(nullptr, q.find(handles[1]));
+    ASSERT_THROW(q.at(handles[1]), std::out_of_range);
+    ASSERT_THROW(q[handles[1]], std::out_of_range);
+    ASSERT_THROW(q.update(handles[1], 3), std::out_of_range);
+    ASSERT_FALSE(q.erase(handles[1]));
+    for (size_t i = 0; i < capacity; i++) {
+        if (i != 1) {
+            ASSERT_EQ(static_cast<int>((i * 7) % capacity), q[handles[i]]);
+        }
+    }
+}
+
+TEST_F(FullQueue, EraseLast) {
+    auto last = q.handle_of(q.end() - 1);
+    ASSERT_TRUE(q.erase(last));
+    ASSERT_TRUE(is_heap(q));
+    ASSERT_EQ(capacity - 1, drain(q).size());
+}
+
+TEST_F(FullQueue, ReusedSlotGetsNewGeneration) {
+    q.erase(handles[2]);
+    auto h = q.push(42);
+    ASSERT_EQ(handles[2].index, h.index); // The released slot is recycled
+    ASSERT_NE(handles[2], h);
+    ASSERT_FALSE(q.contains(handles[2]));
+    ASSERT_EQ(h, q.top_handle());
+}
+
+TEST_F(FullQueue, ClearMakesAllHandlesStale) {
+    q.clear();
+    ASSERT_TRUE(q.empty());
+    for (auto h : handles) {
+        ASSERT_FALSE(q.contains(h));
+    }
+    for (size_t i = 0; i < capacity; i++) {
+        auto h = q.push(i);
+        ASSERT_EQ(std::count(handles.begin(), handles.end(), h), 0);
+    }
+}
+
+TEST_F(FullQueue, CopyAndMove) {
+    q.erase(handles[4]);
+    cdt::FixedPriorityQueue<int, capacity> c(q);
+    ASSERT_EQ(q[handles[5]], c[handles[5]]);
+    ASSERT_FALSE(c.contains(handles[4]));
+    c.update(handles[0], 99);
+    ASSERT_EQ(0, q[handles[0]]);
+    ASSERT_EQ(handles[0], c.top_handle());
+
+    cdt::FixedPriorityQueue<int, capacity> d;
+    d = c;
+    ASSERT_EQ(99, d.top());
+    cdt::FixedPriorityQueue<int, capacity> e(std::move(d));
+    ASSERT_EQ(99, e.top());
+    ASSERT_TRUE(d.empty());
+    ASSERT_FALSE(d.contains(handles[0]));
+    // Handles keep referring to their elements in the moved-to queue
+    ASSERT_EQ(handles[0], e.top_handle());
+    for (auto it = e.begin(); it != e.end(); ++it) {
+        ASSERT_EQ(&*it, e.find(e.handle_of(it)));
+    }
+    e.pop();
+    ASSERT_FALSE(e.contains(handles[0]));
+    ASSERT_TRUE(e.erase(handles[5]));
+    for (size_t i = 1; i < capacity; i++) {
+        if (i != 4 && i != 5) {
+            ASSERT_EQ(static_cast<int>((i * 7) % capacity), e[handles[i]]);
+        }
+    }
+    ASSERT_TRUE(is_heap(e));
+
+    d = std::move(e);
+    ASSERT_EQ(capacity - 3, d.size());
+    ASSERT_TRUE(e.empty());
+    for (auto it = d.begin(); it != d.end(); ++it) {
+        ASSERT_EQ(&*it, d.find(d.handle_of(it)));
+    }
+    ASSERT_TRUE(d.erase(handles[1]));
+    d.pop();
+    ASSERT_EQ(capacity - 5, d.size());
+    for (size_t i = 2; i < capacity; i++) {
+        if (d.contains(handles[i])) {
+            ASSERT_EQ(static_cast<int>((i * 7) % capacity), d[handles[i]]);
+        }
+    }
+    std::vector<int> drained = drain(d);
+    ASSERT_TRUE(std::is_sorted(drained.rbegin(), drained.rend()));
+    ASSERT_EQ(capacity - 5, drained.size());
+    e.push(7);
+    ASSERT_EQ(7, e.top());
+}
+
+TEST_F(FullQueue, MovedFromKeepsHandlesStale) {
+    cdt::FixedPriorityQueue<int, capacity> c(std::move(q));
+    for (size_t i = 0; i < capacity; i++) {
+        q.push(i);
+    }
+    cdt::FixedPriorityQueue<int, capacity> d;
+    d = std::move(q);
+    for (size_t i = 0; i < capacity; i++) {
+        q.push(i);
+    }
+    for (auto h : handles) {
+        ASSERT_FALSE(q.contains(h));
+        ASSERT_FALSE(d.contains(h));
+        ASSERT_TRUE(c.contains(h));
+    }
+}
+
+TEST(FixedPriorityQueue, Destroys) {
+    {
+        cdt::FixedPriorityQueue<Tracked, 8> q;
+        std::vector<cdt::FixedPriorityQueue<Tracked, 8>::Handle> handles;
+        for (int i = 0; i < 8; i++) {
+            handles.push_back(q.emplace(i));
+        }
+        ASSERT_EQ(8, Tracked::alive);
+        q.erase(handles[3]);
+        q.pop();
+        ASSERT_EQ(6, Tracked::alive);
+        q.update(handles[0], Tracked(10));
+        ASSERT_EQ(10, q.top().value);
+        ASSERT_EQ(6, Tracked::alive);
+        q.clear();
+        ASSERT_EQ(0, Tracked::alive);
+        q.emplace(1);
+    }
+    ASSERT_EQ(0, Tracked::alive);
+}
+
+TEST(FixedPriorityQueue, MoveOnly) {
+    typedef std::unique_ptr<int> Ptr;
+    auto less = [](const Ptr& a, const Ptr& b) { return *a < *b; };
+    cdt::FixedPriorityQueue<Ptr, 8, decltype(less)> q(less);
+    auto h = q.push(Ptr(new int(1)));
+    q.emplace(new int(3));
+    q.decrease_key(h, Ptr(new int(5)));
+    ASSERT_EQ(5, *q.top());
+    q.pop();
+    ASSERT_EQ(3, *q.top());
+}
+
+TEST(FixedPriorityQueue, String) {
+    cdt::FixedPriorityQueue<std::string, 3> q;
+    auto a = q.push("first element, long enough to be allocated");
+    auto b = q.push("second");
+    q.erase(a);
+    ASSERT_EQ("second", q[b]);
+    ASSERT_EQ("second", q.top());
+}
+
+TEST(FixedPriorityQueue, RandomAgainstMultimap) {
+    typedef cdt::FixedPriorityQueue<int, 300, std::greater<int>> Queue;
+    Queue q;
+    std::multimap<int, Queue::Handle> live; // Smallest first
+    std::vector<Queue::Handle> dead;
+    std::mt19937 rng(11);
+    auto random_entry = [&] { return std::next(live.begin(), rng() % live.size()); };
+    for (int step = 0; step < 20000; step++) {
+        const unsigned op = rng() % 6;
+        if (live.size() < q.capacity() && (live.empty() || op < 2)) {
+            const int value = rng() % 1000;
+            live.emplace(value, q.push(value));
+        } else if (op == 2) {
+            ASSERT_EQ(live.begin()->first, q.top());
+            auto h = q.top_handle();
+            ASSERT_EQ(live.begin()->first, q[h]);
+            q.pop();
+            live.erase(std::find_if(live.begin(), live.end(), [h](const std::pair<const int, Queue::Handle>& e) { return e.second == h; }));
+            dead.push_back(h);
+        } else if (op == 3) {
+            auto it = random_entry();
+            ASSERT_TRUE(q.erase(it->second));
+            dead.push_back(it->second);
+            live.erase(it);
+        } else if (op == 4) {
+            auto it = random_entry();
+            const int value = rng() % 1000;
+            q.update(it->second, value);
+            live.emplace(value, it->second);
+            live.erase(it);
+        } else {
+            auto it = random_entry();
+            const int value = it->first - static_cast<int>(rng() % 100);
+            q.decrease_key(it->second, value);
+            live.emplace(value, it->second);
+            live.erase(it);
+        }
+        ASSERT_EQ(live.size(), q.size());
+        if (!live.empty()) {
+            ASSERT_EQ(live.begin()->first, q.top());
+        }
+        if (step % 100 == 0) {
+            ASSERT_TRUE(is_heap(q));
+            for (const auto& kv : live) {
+                ASSERT_EQ(kv.first, q[kv.second]);
+            }
+            for (auto h : dead) {
+                ASSERT_FALSE(q.contains(h));
+            }
+            dead.clear();
+        }
+    }
+}
@@ -0,0 +1,175 @@
+#include <array_list/fixedring.hpp>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+
+// Set up fixtures
+class EmptyFixedring : public ::testing::Test {
+public:
+    EmptyFixedring(){};
+    static constexpr size_t capacity = 5;
+    cdt::FixedRing<int, capacity> r;
+};
+constexpr size_t EmptyFixedring::capacity;
+
+class FullFixedring : public ::testing::Test {
+public:
+    FullFixedring() {
+        for (size_t i = 0; i < capacity; i++) {
+            r.try_push(i);
+        }
+    };
+    static constexpr size_t capacity = 5;
+    cdt::FixedRing<int, capacity> r;
+};
+constexpr size_t FullFixedring::capacity;
+
+/* ------------------------------------------------------------- */
+TEST_F(EmptyFixedring, EmptySize) {
+    ASSERT_EQ(0, r.size());
+    ASSERT_TRUE(r.empty());
+    ASSERT_EQ(capacity, r.capacity());
+    int x;
+    ASSERT_FALSE(r.try_pop(x));
+}
+
+TEST_F(EmptyFixedring, PushPop) {
+    ASSERT_TRUE(r.try_push(1));
+    ASSERT_TRUE(r.try_push(2));
+    ASSERT_EQ(2, r.size());
+    int x;
+    ASSERT_TRUE(r.try_pop(x));
+    ASSERT_EQ(1, x);
+    ASSERT_TRUE(r.try_pop(x));
+    ASSERT_EQ(2, x);
+    ASSERT_FALSE(r.try_pop(x));
+}
+
+TEST_F(FullFixedring, Overfill) {
+    ASSERT_EQ(capacity, r.size());
+    ASSERT_FALSE(r.try_push(0));
+    ASSERT_EQ(capacity, r.size());
+}
+
+TEST_F(FullFixedring, FifoOrderAcrossWrapAround) {
+    int x;
+    for (int i = 0; i < 23; i++) {
+        ASSERT_TRUE(r.try_pop(x));
+        ASSERT_EQ(i, x);
+        ASSERT_TRUE(r.try_push(i + capacity));
+        ASSERT_EQ(capacity, r.size());
+    }
+}
+
+/* ------------------------------------------------------------- */
+TEST_F(EmptyFixedring, Batches) {
+    std::vector<int> in{0, 1, 2, 3, 4, 5, 6};
+    ASSERT_EQ(3, r.push_n(in.begin(), 3));
+    ASSERT_EQ(2, r.push_n(in.begin() + 3, 4));
+    ASSERT_EQ(0, r.push_n(in.begin() + 5, 2));
+    std::vector<int> out;
+    ASSERT_EQ(4, r.pop_n(std::back_inserter(out), 4));
+    ASSERT_EQ(3, r.push_n(in.begin() + 4, 3));
+    ASSERT_EQ(4, r.pop_n(std::back_inserter(out), 10));
+    std::vector<int> expected{0, 1, 2, 3, 4, 4, 5, 6};
+    ASSERT_EQ(expected, out);
+    ASSERT_TRUE(r.empty());
+}
+
+TEST(FixedRingLifetime, DestroysElements) {
+    std::shared_ptr<int> tracked = std::make_shared<int>(1);
+    {
+        cdt::FixedRing<std::shared_ptr<int>, 4> r;
+        r.try_push(tracked);
+        r.try_push(tracked);
+        r.try_emplace(tracked);
+        ASSERT_EQ(4, tracked.use_count());
+        std::shared_ptr<int> x;
+        r.try_pop(x);
+        x.reset();
+        ASSERT_EQ(3, tracked.use_count());
+    }
+    ASSERT_EQ(1, tracked.use_count());
+}
+
+/// Copies of a failing instance throw, to interrupt batches
+struct Fragile {
+    Fragile(std::shared_ptr<int> p, bool fail = false) : p(p), fail(fail) {
+    }
+    Fragile(const Fragile& other) : p(other.p), fail(other.fail) {
+        if (fail) {
+            throw std::runtime_error("Copy failed.");
+        }
+    }
+    Fragile& operator=(const Fragile&) = default;
+    std::shared_ptr<int> p;
+    bool fail;
+};
+
+TEST(FixedRingLifetime, ThrowingPushN) {
+    std::shared_ptr<int> tracked = std::make_shared<int>(1);
+    {
+        cdt::FixedRing<Fragile, 4> r;
+        std::vector<Fragile> in;
+        in.reserve(3);
+        in.emplace_back(tracked);
+        in.emplace_back(tracked);
+        in.emplace_back(tracked, true);
+        ASSERT_THROW(r.push_n(in.begin(), 3), std::runtime_error);
+        ASSERT_EQ(2, r.size()); // The elements copied before are published
+        ASSERT_EQ(6, tracked.use_count());
+    }
+    ASSERT_EQ(1, tracked.use_count());
+}
+
+TEST(FixedRingLifetime, ThrowingPopN) {
+    std::shared_ptr<int> tracked = std::make_shared<int>(1);
+    std::vector<Fragile> out;
+    out.reserve(4);
+    {
+        cdt::FixedRing<Fragile, 4> r;
+        r.try_emplace(tracked);
+        r.try_emplace(tracked, true);
+        r.try_emplace(tracked);
+        ASSERT_THROW(r.pop_n(std::back_inserter(out), 3), std::runtime_error);
+        ASSERT_EQ(1, out.size());
+        ASSERT_EQ(2, r.size()); // The failed element stays in the ring
+        ASSERT_EQ(4, tracked.use_count());
+    }
+    ASSERT_EQ(2, tracked.use_count());
+}
+
+/* ------------------------------------------------------------- */
+TEST(FixedRingConcurrency, SingleProducerSingleConsumer) {
+    constexpr int count = 20000;
+    cdt::FixedRing<int, 64> r;
+    std::thread producer([&r]() {
+        for (int i = 0; i < count;) {
+            if (i % 3 == 0) {
+                int batch[3] = {i, i + 1, i + 2};
+                i += r.push_n(batch, std::min(3, count - i));
+            } else if (r.try_push(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    int expected = 0;
+    while (expected < count) {
+        int x[4];
+        size_t n = r.pop_n(x, 4);
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+        for (size_t k = 0; k < n; k++) {
+            ASSERT_EQ(expected++, x[k]);
+        }
+    }
+    producer.join();
+    ASSERT_TRUE(r.empty());
+}
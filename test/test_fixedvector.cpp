@@ -1,7 +1,11 @@
 #include <array_list/fixedvector.hpp>
 #include <cmath>
 #include "gtest/gtest.h"
+#include "tracked.hpp"
 #include <algorithm>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 // Set up fixtures
 class EmptyFixedvector : public ::testing::Test {
@@ -47,11 +51,28 @@ TEST_F(FullFixedvector, Assertion) {
     ASSERT_THROW(l[-1], std::out_of_range);
 }
 
+TEST_F(FullFixedvector, AtAccess) {
+    for (size_t i = 0; i < capacity; i++) {
+        ASSERT_EQ(i, l.at(i));
+    }
+    ASSERT_THROW(l.at(capacity), std::out_of_range);
+    const auto& cl = l;
+    ASSERT_THROW(cl.at(capacity), std::out_of_range);
+}
+
 TEST_F(FullFixedvector, Overfill) {
     ASSERT_EQ(l.capacity(), l.size());
     ASSERT_THROW(l.push_back(0), std::out_of_range);
 }
 
+TEST_F(FullFixedvector, StatsDisabled) {
+    // Without CDT_ENABLE_STATS nothing is recorded and the recorder takes no space
+    ASSERT_TRUE(std::is_empty<cdt::detail::UsageRecorder>::value);
+    ASSERT_EQ(sizeof(cdt::detail::FixedVectorStorage<int, capacity>), sizeof(l));
+    ASSERT_EQ(0, l.stats().inserts);
+    ASSERT_EQ(0, l.stats().high_water_mark);
+}
+
 /* ------------------------------------------------------------- */
 TEST_F(EmptyFixedvector, EmptySize) {
     ASSERT_EQ(0, l.size());
@@ -79,6 +100,17 @@ TEST_F(FullFixedvector, MaxSize) {
 //               sizeof(l));                                  // Actual size
 // }
 
+TEST(FixedVectorIndexWidth, FillLargestNarrowCapacity) {
+    cdt::FixedVector<uint8_t, 255> l;
+    ASSERT_EQ(255 + 1, sizeof(l));
+    for (int i = 0; i < 255; i++) {
+        l.push_back(i);
+    }
+    ASSERT_THROW(l.push_back(0), std::out_of_range);
+    ASSERT_EQ(255, l.size());
+    ASSERT_THROW(l[256], std::out_of_range);
+}
+
 /* ------------------------------------------------------------- */
 TEST_F(FullFixedvector, SubscriptAccess) {
     for (size_t i = 0; i < capacity; i++) {
@@ -180,6 +212,206 @@ TEST_F(FullFixedvector, IteratorDecrementPostfix) {
     }
 }
 
-/// TODO
-/// - Copy constructor -> size()?
-/// Test valid pointers
\ No newline at end of file
+/* ------------------------------------------------------------- */
+static_assert(std::is_trivially_destructible<cdt::FixedVector<int, 5>>::value,
+              "FixedVector of trivial types has to be trivially destructible.");
+static_assert(!std::is_trivially_destructible<cdt::FixedVector<Tracked, 5>>::value,
+              "FixedVector has to destroy its elements.");
+static_assert(std::is_nothrow_move_constructible<cdt::FixedVector<int, 5>>::value &&
+                      std::is_nothrow_move_assignable<cdt::FixedVector<std::string, 5>>::value,
+              "FixedVector moves do not throw, if moving its elements does not.");
+static_assert(!std::is_nothrow_move_constructible<cdt::FixedVector<Tracked, 5>>::value,
+              "FixedVector moves may throw, if moving its elements may.");
+
+TEST(FixedVectorLifetime, NoElementConstructedUpFront) {
+    Tracked::alive = 0;
+    cdt::FixedVector<Tracked, 10> l;
+    ASSERT_EQ(0, Tracked::alive);
+}
+
+TEST(FixedVectorLifetime, EmplaceBack) {
+    Tracked::alive = 0;
+    cdt::FixedVector<Tracked, 3> l;
+    ASSERT_EQ(1, l.emplace_back(1).value);
+    l.emplace_back(2);
+    l.emplace_back(3);
+    ASSERT_EQ(3, Tracked::alive);
+    ASSERT_THROW(l.emplace_back(4), std::out_of_range);
+    ASSERT_EQ(3, Tracked::alive);
+}
+
+TEST(FixedVectorLifetime, EraseAndClearDestroy) {
+    Tracked::alive = 0;
+    {
+        cdt::FixedVector<Tracked, 10> l;
+        for (int i = 0; i < 5; i++) {
+            l.emplace_back(i);
+        }
+        l.erase(l.begin());
+        ASSERT_EQ(4, l.front().value);
+        l.pop_back();
+        ASSERT_EQ(3, Tracked::alive);
+        l.clear();
+        ASSERT_EQ(0, Tracked::alive);
+        l.emplace_back(7);
+    }
+    ASSERT_EQ(0, Tracked::alive);
+}
+
+TEST(FixedVectorLifetime, Copy) {
+    Tracked::alive = 0;
+    cdt::FixedVector<Tracked, 10> l;
+    for (int i = 0; i < 5; i++) {
+        l.emplace_back(i);
+    }
+    cdt::FixedVector<Tracked, 10> copy(l);
+    ASSERT_EQ(10, Tracked::alive);
+    copy.pop_back();
+    l = copy;
+    ASSERT_EQ(8, Tracked::alive);
+    ASSERT_EQ(3, l.back().value);
+}
+
+TEST_F(FullFixedvector, TrivialCopyAndMove) {
+    decltype(l) copy(l);
+    ASSERT_TRUE(std::equal(l.begin(), l.end(), copy.begin()));
+    decltype(l) moved(std::move(copy));
+    ASSERT_EQ(capacity, moved.size());
+    ASSERT_TRUE(copy.empty());
+    copy = moved;
+    ASSERT_TRUE(std::equal(l.begin(), l.end(), copy.begin()));
+}
+/* ------------------------------------------------------------- */
+/// Search and reduction kernels, checked against the std algorithms for all vector widths and tails
+template <typename _Tp>
+class FixedVectorKernels : public ::testing::Test {};
+typedef ::testing::Types<int32_t, uint32_t, float, double, int16_t> KernelTypes;
+TYPED_TEST_SUITE(FixedVectorKernels, KernelTypes);
+
+TYPED_TEST(FixedVectorKernels, FindCountContains) {
+    for (size_t n = 0; n < 40; n++) {
+        cdt::FixedVector<TypeParam, 40> l;
+        for (size_t i = 0; i < n; i++) {
+            l.push_back(static_cast<TypeParam>(i % 7));
+        }
+        for (int x = -1; x < 8; x++) {
+            const TypeParam value = static_cast<TypeParam>(x);
+            ASSERT_EQ(std::find(l.begin(), l.end(), value), l.find(value));
+            ASSERT_EQ(std::count(l.begin(), l.end(), value), l.count(value));
+            ASSERT_EQ(std::find(l.begin(), l.end(), value) != l.end(), l.contains(value));
+        }
+    }
+}
+
+TYPED_TEST(FixedVectorKernels, MinMaxElement) {
+    for (size_t n = 0; n < 40; n++) {
+        cdt::FixedVector<TypeParam, 40> l;
+        for (size_t i = 0; i < n; i++) {
+            l.push_back(static_cast<TypeParam>((i * 13 + 5) % 17));
+        }
+        ASSERT_EQ(std::min_element(l.begin(), l.end()), l.min_element());
+        ASSERT_EQ(std::max_element(l.begin(), l.end()), l.max_element());
+    }
+}
+
+TYPED_TEST(FixedVectorKernels, Remove) {
+    for (size_t n = 0; n < 40; n++) {
+        cdt::FixedVector<TypeParam, 40> l;
+        std::vector<TypeParam> expected;
+        for (size_t i = 0; i < n; i++) {
+            const TypeParam x = static_cast<TypeParam>((i * 5) % 3);
+            l.push_back(x);
+            if (x != 1) {
+                expected.push_back(x);
+            }
+        }
+        ASSERT_EQ(n - expected.size(), l.remove(1));
+        ASSERT_EQ(expected.size(), l.size());
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+    }
+}
+
+TEST(FixedVectorKernelsSigned, MinMaxOfNegativeValues) {
+    cdt::FixedVector<int32_t, 40> l;
+    for (int i = 0; i < 37; i++) {
+        l.push_back(i % 2 ? -i : i);
+    }
+    ASSERT_EQ(-35, *l.min_element());
+    ASSERT_EQ(36, *l.max_element());
+    cdt::FixedVector<uint32_t, 40> u;
+    for (int i = 0; i < 37; i++) {
+        u.push_back(i == 20 ? 0xffffffffu : i);
+    }
+    ASSERT_EQ(0xffffffffu, *u.max_element());
+    ASSERT_EQ(0u, *u.min_element());
+}
+
+TEST(FixedVectorErase, EraseIfKeepsOrder) {
+    cdt::FixedVector<int, 20> l;
+    for (int i = 0; i < 20; i++) {
+        l.push_back(i);
+    }
+    ASSERT_EQ(10, l.erase_if([](int x) { return x % 2; }));
+    ASSERT_EQ(10, l.size());
+    for (int i = 0; i < 10; i++) {
+        ASSERT_EQ(2 * i, l[i]);
+    }
+    ASSERT_EQ(0, l.erase_if([](int x) { return x > 100; }));
+    ASSERT_EQ(10, l.erase_if([](int) { return true; }));
+    ASSERT_TRUE(l.empty());
+}
+
+TEST(FixedVectorErase, EraseIfUnordered) {
+    cdt::FixedVector<int, 20> l;
+    for (int i = 0; i < 20; i++) {
+        l.push_back(i);
+    }
+    ASSERT_EQ(10, l.erase_if_unordered([](int x) { return x % 2; }));
+    ASSERT_EQ(10, l.size());
+    std::vector<int> remaining(l.begin(), l.end());
+    std::sort(remaining.begin(), remaining.end());
+    for (int i = 0; i < 10; i++) {
+        ASSERT_EQ(2 * i, remaining[i]);
+    }
+    ASSERT_EQ(0, l.erase_if_unordered([](int x) { return x > 100; }));
+    ASSERT_EQ(10, l.erase_if_unordered([](int) { return true; }));
+    ASSERT_TRUE(l.empty());
+}
+
+TEST(FixedVectorLifetime, EraseIfUnorderedDestroys) {
+    Tracked::alive = 0;
+    cdt::FixedVector<Tracked, 10> l;
+    for (int i = 0; i < 10; i++) {
+        l.emplace_back(i);
+    }
+    ASSERT_EQ(4, l.erase_if_unordered([](const Tracked& t) { return t.value % 3 == 0; }));
+    ASSERT_EQ(6, Tracked::alive);
+    for (const Tracked& t : l) {
+        ASSERT_NE(0, t.value % 3);
+    }
+}
+
+TEST(FixedVectorLifetime, EraseIfDestroys) {
+    Tracked::alive = 0;
+    cdt::FixedVector<Tracked, 10> l;
+    for (int i = 0; i < 10; i++) {
+        l.emplace_back(i);
+    }
+    ASSERT_EQ(4, l.erase_if([](const Tracked& t) { return t.value % 3 == 0; }));
+    ASSERT_EQ(6, Tracked::alive);
+    std::vector<int> expected{1, 2, 4, 5, 7, 8};
+    for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_EQ(expected[i], l[i].value);
+    }
+}
+
+TEST(FixedVectorErase, RemoveNonArithmetic) {
+    cdt::FixedVector<std::string, 10> l;
+    for (int i = 0; i < 10; i++) {
+        l.push_back(i % 3 ? "keep" : "drop");
+    }
+    ASSERT_EQ(4, l.remove("drop"));
+    ASSERT_EQ(6, l.count("keep"));
+    ASSERT_FALSE(l.contains("drop"));
+    ASSERT_EQ(l.begin(), l.min_element());
+}
@@ -0,0 +1,83 @@
+#include <array_list/arraylist.hpp>
+#include <array_list/parallel.hpp>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+
+typedef cdt::ArrayList<long, 100000> List;
+
+// Set up fixtures
+class ForEachParallel : public ::testing::Test {
+public:
+    ForEachParallel() {
+        for (long i = 0; i < 90000; i++) {
+            l.push_front(i);
+        }
+        l.remove_if([](long x) { return x % 3 == 0; });
+    };
+    List l;
+};
+
+/* ------------------------------------------------------------- */
+TEST_F(ForEachParallel, VisitsEveryElementOnce) {
+    std::vector<long> expected(l.begin(), l.end());
+    cdt::for_each_parallel(l, [](long& x) { x = 2 * x + 1; }, 4, 1000);
+    ASSERT_EQ(expected.size(), l.size());
+    size_t k = 0;
+    for (long x : l) {
+        ASSERT_EQ(2 * expected[k++] + 1, x);
+    }
+}
+
+TEST_F(ForEachParallel, UsesThreads) {
+    std::atomic<size_t> count(0);
+    std::atomic<size_t> foreign(0);
+    const std::thread::id caller = std::this_thread::get_id();
+    cdt::for_each_parallel(
+            l,
+            [&](long&) {
+                count++;
+                foreign += std::this_thread::get_id() != caller;
+            },
+            4, 1000);
+    ASSERT_EQ(l.size(), count);
+    ASSERT_LT(0, foreign);
+}
+
+TEST_F(ForEachParallel, ConstList) {
+    const List& c = l;
+    std::atomic<long> sum(0);
+    cdt::for_each_parallel(c, [&sum](const long& x) { sum += x; }, 3, 1000);
+    long expected = 0;
+    for (long x : c) {
+        expected += x;
+    }
+    ASSERT_EQ(expected, sum);
+}
+
+TEST_F(ForEachParallel, SmallListStaysOnCaller) {
+    l.erase(l.nth(10), l.end());
+    l.compact();
+    std::vector<long> seen;
+    const std::thread::id caller = std::this_thread::get_id();
+    cdt::for_each_parallel(l, [&](long& x) {
+        ASSERT_EQ(caller, std::this_thread::get_id());
+        seen.push_back(x);
+    });
+    ASSERT_EQ(std::vector<long>(l.begin(), l.end()), seen); // A compact list is visited in list order
+}
+
+TEST_F(ForEachParallel, Exception) {
+    ASSERT_THROW(cdt::for_each_parallel(
+                         l,
+                         [](long& x) {
+                             if (x == 50000) {
+                                 throw std::runtime_error("stop");
+                             }
+                         },
+                         4, 1000),
+                 std::runtime_error);
+}
@@ -0,0 +1,175 @@
+#include <array_list/arraylist.hpp>
+#include <array_list/fixedvector.hpp>
+#include <array_list/shared_container.hpp>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#include "gtest/gtest.h"
+
+typedef cdt::ArrayList<int, 1024> List;
+typedef cdt::FixedVector<int, 64> Vector;
+
+// Set up fixtures
+class SharedContainer : public ::testing::Test {
+public:
+    SharedContainer() : name("/cdt_test_" + std::to_string(::getpid())) {
+        cdt::SharedContainer<List>::remove(name);
+    }
+    ~SharedContainer() {
+        cdt::SharedContainer<List>::remove(name);
+    }
+
+    /// Run fn in a child process, returns its exit code
+    template <typename _Function>
+    static int in_child(_Function fn) {
+        const pid_t pid = ::fork();
+        if (pid == 0) {
+            int code = 1;
+            try {
+                code = fn();
+            } catch (...) {
+            }
+            ::_exit(code);
+        }
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
+
+    const std::string name;
+};
+
+/* ------------------------------------------------------------- */
+TEST_F(SharedContainer, CreateAndOpen) {
+    auto created = cdt::SharedContainer<List>::create(name);
+    created.modify([](List& l) { l.push_back(1); });
+    auto opened = cdt::SharedContainer<List>::open(name);
+    ASSERT_EQ(1, opened.inspect([](const List& l) { return l.size(); }));
+    opened.modify([](List& l) { l.push_back(2); });
+    ASSERT_EQ(2, created.inspect([](const List& l) { return l.back(); }));
+    ASSERT_EQ(2, created.version());
+}
+
+TEST_F(SharedContainer, CreateExisting) {
+    auto created = cdt::SharedContainer<List>::create(name);
+    ASSERT_THROW(cdt::SharedContainer<List>::create(name), std::system_error);
+}
+
+TEST_F(SharedContainer, OpenMissing) {
+    ASSERT_THROW(cdt::SharedContainer<List>::open(name), std::system_error);
+}
+
+TEST_F(SharedContainer, OpenDifferentType) {
+    auto created = cdt::SharedContainer<List>::create(name);
+    ASSERT_THROW(cdt::SharedContainer<Vector>::open(name), std::runtime_error);
+}
+
+TEST_F(SharedContainer, Read) {
+    auto shared = cdt::SharedContainer<List>::create(name);
+    shared.modify([](List& l) {
+        for (int i = 0; i < 10; i++) {
+            l.push_back(i);
+        }
+        l.erase(l.nth(3));
+    });
+    List copy;
+    shared.read(copy);
+    ASSERT_EQ(9, copy.size());
+    ASSERT_EQ(4, copy[3]);
+    copy.push_back(10); // The copy is independent
+    ASSERT_EQ(9, shared.inspect([](const List& l) { return l.size(); }));
+}
+
+TEST_F(SharedContainer, ModifyInOtherProcess) {
+    auto shared = cdt::SharedContainer<List>::create(name);
+    const std::string segment = name;
+    const int code = in_child([&segment] {
+        auto opened = cdt::SharedContainer<List>::open(segment);
+        opened.modify([](List& l) {
+            for (int i = 0; i < 1000; i++) {
+                l.push_front(i);
+            }
+        });
+        return 0;
+    });
+    ASSERT_EQ(0, code);
+    shared.inspect([](const List& l) {
+        ASSERT_EQ(1000, l.size());
+        ASSERT_EQ(999, l.front());
+        ASSERT_EQ(0, l.back());
+    });
+}
+
+TEST_F(SharedContainer, ConsistentReadsDuringWrites) {
+    auto shared = cdt::SharedContainer<Vector>::create(name);
+    const std::string segment = name;
+    // The parent writes, while a child reads. Every write fills the vector with copies of its size.
+    const pid_t reader = ::fork();
+    if (reader == 0) {
+        int code = 0;
+        try {
+            auto opened = cdt::SharedContainer<Vector>::open(segment);
+            Vector copy;
+            while (opened.version() < 20000) {
+                opened.read(copy);
+                for (int x : copy) {
+                    code |= x != static_cast<int>(copy.size());
+                }
+            }
+        } catch (...) {
+            code = 1;
+        }
+        ::_exit(code);
+    }
+    for (int k = 1; k <= 20000; k++) {
+        shared.modify([k](Vector& v) {
+            v.clear();
+            for (int i = 0; i < k % 64 + 1; i++) {
+                v.push_back(k % 64 + 1);
+            }
+        });
+    }
+    int status = 0;
+    ::waitpid(reader, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(0, WEXITSTATUS(status));
+}
+
+TEST_F(SharedContainer, OwnerDied) {
+    auto shared = cdt::SharedContainer<List>::create(name);
+    const std::string segment = name;
+    in_child([&segment] {
+        auto opened = cdt::SharedContainer<List>::open(segment);
+        opened.modify([](List& l) {
+            l.push_back(1);
+            ::_exit(0); // Dies while holding the mutex
+        });
+        return 1;
+    });
+    // The mutex is recovered and the interrupted modification is closed
+    ASSERT_EQ(1, shared.modify([](List& l) { return l.size(); }));
+    List copy;
+    shared.read(copy);
+    ASSERT_EQ(1, copy.size());
+}
+
+TEST_F(SharedContainer, ReadAfterOwnerDied) {
+    auto shared = cdt::SharedContainer<List>::create(name);
+    const std::string segment = name;
+    in_child([&segment] {
+        auto opened = cdt::SharedContainer<List>::open(segment);
+        opened.modify([](List& l) {
+            l.push_back(1);
+            ::_exit(0); // Dies while holding the mutex, the sequence stays odd
+        });
+        return 1;
+    });
+    // Only reading falls back to the mutex, which recovers it and closes the interrupted modification
+    List copy;
+    shared.read(copy);
+    ASSERT_EQ(1, copy.size());
+    ASSERT_EQ(1, shared.version());
+    shared.read(copy);
+    ASSERT_EQ(1, copy.front());
+}
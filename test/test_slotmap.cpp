@@ -0,0 +1,263 @@
+#include <array_list/slotmap.hpp>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "tracked.hpp"
+
+// Set up fixtures
+class EmptySlotmap : public ::testing::Test {
+public:
+    EmptySlotmap(){};
+    static constexpr size_t capacity = 5;
+    cdt::SlotMap<int, capacity> m;
+};
+constexpr size_t EmptySlotmap::capacity;
+
+class FullSlotmap : public ::testing::Test {
+public:
+    typedef cdt::SlotMap<int, 5>::Handle Handle;
+    FullSlotmap() {
+        for (size_t i = 0; i < capacity; i++) {
+            handles.push_back(m.insert(i));
+        }
+    };
+    static constexpr size_t capacity = 5;
+    cdt::SlotMap<int, capacity> m;
+    std::vector<Handle> handles;
+};
+constexpr size_t FullSlotmap::capacity;
+
+/* ------------------------------------------------------------- */
+TEST_F(EmptySlotmap, EmptySize) {
+    ASSERT_EQ(0, m.size());
+    ASSERT_TRUE(m.empty());
+    ASSERT_EQ(capacity, m.capacity());
+    ASSERT_EQ(m.begin(), m.end());
+}
+
+TEST_F(EmptySlotmap, DefaultHandleIsStale) {
+    cdt::SlotMap<int, capacity>::Handle h;
+    ASSERT_FALSE(m.contains(h));
+    ASSERT_EQ(nullptr, m.find(h));
+    ASSERT_FALSE(m.erase(h));
+    m.insert(1);
+    ASSERT_FALSE(m.contains(h));
+}
+
+TEST_F(EmptySlotmap, InsertLookup) {
+    auto a = m.insert(1);
+    auto b = m.emplace(2);
+    ASSERT_NE(a, b);
+    ASSERT_EQ(2, m.size());
+    ASSERT_TRUE(m.contains(a));
+    ASSERT_EQ(1, m[a]);
+    ASSERT_EQ(2, *m.find(b));
+    m.at(b) = 3;
+    ASSERT_EQ(3, m[b]);
+}
+
+TEST_F(FullSlotmap, InsertIntoFull) {
+    ASSERT_EQ(capacity, m.size());
+    ASSERT_THROW(m.insert(1), std::length_error);
+    ASSERT_EQ(capacity, m.size());
+}
+
+TEST_F(FullSlotmap, EraseMakesHandleStale) {
+    ASSERT_TRUE(m.erase(handles[1]));
+    ASSERT_EQ(capacity - 1, m.size());
+    ASSERT_FALSE(m.contains(handles[1]));
+    ASSERT_EQ(nullptr, m.find(handles[1]));
+    ASSERT_THROW(m.at(handles[1]), std::out_of_range);
+    ASSERT_THROW(m[handles[1]], std::out_of_range);
+    ASSERT_FALSE(m.erase(handles[1]));
+    // The other handles still refer to their elements
+    for (size_t i = 0; i < capacity; i++) {
+        if (i != 1) {
+            ASSERT_EQ(static_cast<int>(i), m[handles[i]]);
+        }
+    }
+}
+
+TEST_F(FullSlotmap, ReusedSlotGetsNewGeneration) {
+    m.erase(handles[2]);
+    auto h = m.insert(42);
+    ASSERT_EQ(handles[2].index, h.index); // The released slot is recycled
+    ASSERT_NE(handles[2], h);
+    ASSERT_FALSE(m.contains(handles[2]));
+    ASSERT_EQ(42, m[h]);
+}
+
+TEST_F(FullSlotmap, DenseIteration) {
+    m.erase(handles[0]);
+    m.erase(handles[3]);
+    std::vector<int> values(m.begin(), m.end());
+    std::sort(values.begin(), values.end());
+    ASSERT_EQ((std::vector<int>{1, 2, 4}), values);
+    ASSERT_EQ(3, m.end() - m.begin());
+}
+
+TEST_F(FullSlotmap, HandleOf) {
+    m.erase(handles[0]);
+    for (auto it = m.begin(); it != m.end(); ++it) {
+        auto h = m.handle_of(it);
+        ASSERT_EQ(handles[*it], h);
+        ASSERT_EQ(&*it, m.find(h));
+    }
+}
+
+TEST_F(FullSlotmap, EraseByIterator) {
+    for (auto it = m.begin(); it != m.end();) {
+        if (*it % 2 == 0) {
+            it = m.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    ASSERT_EQ(2, m.size());
+    ASSERT_TRUE(m.contains(handles[1]));
+    ASSERT_TRUE(m.contains(handles[3]));
+    ASSERT_FALSE(m.contains(handles[0]));
+}
+
+TEST_F(FullSlotmap, ClearMakesAllHandlesStale) {
+    m.clear();
+    ASSERT_TRUE(m.empty());
+    for (auto h : handles) {
+        ASSERT_FALSE(m.contains(h));
+    }
+    for (size_t i = 0; i < capacity; i++) {
+        auto h = m.insert(i);
+        ASSERT_EQ(std::count(handles.begin(), handles.end(), h), 0);
+    }
+}
+
+TEST_F(FullSlotmap, Copy) {
+    m.erase(handles[4]);
+    cdt::SlotMap<int, capacity> c(m);
+    for (size_t i = 0; i < 4; i++) {
+        ASSERT_EQ(static_cast<int>(i), c[handles[i]]);
+    }
+    ASSERT_FALSE(c.contains(handles[4]));
+    c.erase(handles[0]);
+    ASSERT_TRUE(m.contains(handles[0]));
+
+    cdt::SlotMap<int, capacity> d;
+    d = c;
+    ASSERT_EQ(3, d.size());
+    ASSERT_EQ(3, d[handles[3]]);
+}
+
+TEST_F(FullSlotmap, Move) {
+    cdt::SlotMap<int, capacity> c(std::move(m));
+    ASSERT_EQ(capacity, c.size());
+    ASSERT_EQ(2, c[handles[2]]);
+    ASSERT_TRUE(m.empty());
+    ASSERT_FALSE(m.contains(handles[2]));
+    m.insert(7);
+    ASSERT_EQ(1, m.size());
+}
+
+TEST_F(FullSlotmap, MoveKeepsHandles) {
+    // Erasing moves the last elements into the gaps, so elements no longer sit at the position of their slot
+    m.erase(handles[0]);
+    m.erase(handles[2]);
+    cdt::SlotMap<int, capacity> c(std::move(m));
+    for (auto it = c.begin(); it != c.end(); ++it) {
+        ASSERT_EQ(handles[*it], c.handle_of(it));
+    }
+    ASSERT_TRUE(c.erase(handles[4]));
+    ASSERT_FALSE(c.contains(handles[4]));
+    ASSERT_EQ(1, c[handles[1]]);
+    ASSERT_EQ(3, c[handles[3]]);
+
+    cdt::SlotMap<int, capacity> d;
+    d = std::move(c);
+    ASSERT_TRUE(c.empty());
+    for (auto it = d.begin(); it != d.end(); ++it) {
+        ASSERT_EQ(handles[*it], d.handle_of(it));
+    }
+    ASSERT_TRUE(d.erase(handles[1]));
+    ASSERT_EQ(1, d.size());
+    ASSERT_EQ(3, d[handles[3]]);
+    auto h = d.insert(5);
+    ASSERT_EQ(5, d[h]);
+    ASSERT_EQ(3, d[handles[3]]);
+}
+
+TEST_F(FullSlotmap, MovedFromKeepsHandlesStale) {
+    cdt::SlotMap<int, capacity> c(std::move(m));
+    for (size_t i = 0; i < capacity; i++) {
+        m.insert(i);
+    }
+    cdt::SlotMap<int, capacity> d;
+    d = std::move(m);
+    for (size_t i = 0; i < capacity; i++) {
+        m.insert(i);
+    }
+    for (auto h : handles) {
+        ASSERT_FALSE(m.contains(h));
+        ASSERT_FALSE(d.contains(h));
+        ASSERT_TRUE(c.contains(h));
+    }
+}
+
+TEST(Slotmap, Destroys) {
+    {
+        cdt::SlotMap<Tracked, 8> m;
+        std::vector<cdt::SlotMap<Tracked, 8>::Handle> handles;
+        for (int i = 0; i < 8; i++) {
+            handles.push_back(m.emplace(i));
+        }
+        ASSERT_EQ(8, Tracked::alive);
+        m.erase(handles[3]);
+        m.erase(handles[7]);
+        ASSERT_EQ(6, Tracked::alive);
+        ASSERT_EQ(5, m[handles[5]].value);
+        m.clear();
+        ASSERT_EQ(0, Tracked::alive);
+        m.emplace(1);
+    }
+    ASSERT_EQ(0, Tracked::alive);
+}
+
+TEST(Slotmap, String) {
+    cdt::SlotMap<std::string, 3> m;
+    auto a = m.insert("first element, long enough to be allocated");
+    auto b = m.insert("second");
+    m.erase(a);
+    ASSERT_EQ("second", m[b]);
+    ASSERT_EQ("second", *m.begin());
+}
+
+TEST(Slotmap, RandomAgainstMap) {
+    typedef cdt::SlotMap<int, 64> Map;
+    Map m;
+    std::map<int, Map::Handle> live;
+    std::vector<Map::Handle> dead;
+    std::mt19937 rng(7);
+    int next = 0;
+    for (int step = 0; step < 20000; step++) {
+        if (live.size() < m.capacity() && (live.empty() || rng() % 2)) {
+            live[next] = m.insert(next);
+            next++;
+        } else {
+            auto it = std::next(live.begin(), rng() % live.size());
+            ASSERT_TRUE(m.erase(it->second));
+            dead.push_back(it->second);
+            live.erase(it);
+        }
+        ASSERT_EQ(live.size(), m.size());
+        if (step % 100 == 0) {
+            for (const auto& kv : live) {
+                ASSERT_EQ(kv.first, m[kv.second]);
+            }
+            for (auto h : dead) {
+                ASSERT_FALSE(m.contains(h));
+            }
+            dead.clear();
+        }
+    }
+}
@@ -0,0 +1,120 @@
+#include <array_list/slotpool.hpp>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+
+// Set up fixtures
+class EmptySlotpool : public ::testing::Test {
+public:
+    EmptySlotpool(){};
+    static constexpr size_t capacity = 5;
+    cdt::ConcurrentSlotPool<capacity> p;
+};
+constexpr size_t EmptySlotpool::capacity;
+
+/* ------------------------------------------------------------- */
+TEST_F(EmptySlotpool, EmptySize) {
+    ASSERT_EQ(0, p.size());
+    ASSERT_TRUE(p.empty());
+    ASSERT_EQ(capacity, p.max_size());
+}
+
+TEST_F(EmptySlotpool, AllocateAll) {
+    std::set<size_t> slots;
+    for (size_t i = 0; i < capacity; i++) {
+        size_t slot = p.allocate();
+        ASSERT_LT(slot, capacity);
+        slots.insert(slot);
+    }
+    ASSERT_EQ(capacity, slots.size());
+    ASSERT_EQ(capacity, p.size());
+    ASSERT_THROW(p.allocate(), std::length_error);
+    decltype(p)::position_type slot;
+    ASSERT_FALSE(p.try_allocate(slot));
+}
+
+TEST_F(EmptySlotpool, ReuseReleasedSlots) {
+    for (size_t i = 0; i < capacity; i++) {
+        p.allocate();
+    }
+    p.deallocate(3);
+    p.deallocate(1);
+    ASSERT_EQ(capacity - 2, p.size());
+    ASSERT_EQ(1, p.allocate());
+    ASSERT_EQ(3, p.allocate());
+    ASSERT_THROW(p.allocate(), std::length_error);
+}
+
+/* ------------------------------------------------------------- */
+TEST(SlotpoolConcurrency, NoSlotHandedOutTwice) {
+    constexpr size_t capacity = 16;
+    constexpr int threads = 4;
+    constexpr int rounds = 20000;
+    cdt::ConcurrentSlotPool<capacity> p;
+    std::atomic<int> owners[capacity];
+    for (auto& o : owners) {
+        o = 0;
+    }
+    std::atomic<bool> failed(false);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            decltype(p)::position_type held[3];
+            for (int r = 0; r < rounds; r++) {
+                int n = 0;
+                for (; n < 3 && p.try_allocate(held[n]); n++) {
+                    if (owners[held[n]].fetch_add(1) != 0) {
+                        failed = true;
+                    }
+                }
+                for (int k = 0; k < n; k++) {
+                    owners[held[k]].fetch_sub(1);
+                    p.deallocate(held[k]);
+                }
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    ASSERT_FALSE(failed);
+    ASSERT_EQ(0, p.size());
+    std::set<size_t> slots;
+    for (size_t i = 0; i < capacity; i++) {
+        slots.insert(p.allocate());
+    }
+    ASSERT_EQ(capacity, slots.size());
+}
+
+TEST(SlotpoolConcurrency, NeverFullWhileSlotsAreFree) {
+    // Each thread holds at most its share of the slots, so allocation must always succeed
+    constexpr size_t share = 2;
+    constexpr int threads = 4;
+    constexpr int rounds = 20000;
+    cdt::ConcurrentSlotPool<share * threads> p;
+    std::atomic<bool> failed(false);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            decltype(p)::position_type held[share];
+            for (int r = 0; r < rounds; r++) {
+                size_t n = 0;
+                for (; n < share && p.try_allocate(held[n]); n++) {
+                }
+                if (n < share) {
+                    failed = true;
+                }
+                for (size_t k = 0; k < n; k++) {
+                    p.deallocate(held[k]);
+                }
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    ASSERT_FALSE(failed);
+    ASSERT_EQ(0, p.size());
+}
@@ -0,0 +1,303 @@
+#include <array_list/smallvector.hpp>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "tracked.hpp"
+
+// Set up fixtures
+class FullSmallvector : public ::testing::Test {
+public:
+    FullSmallvector() {
+        for (size_t i = 0; i < capacity; i++) {
+            l.push_back(i);
+        }
+    };
+    static constexpr size_t capacity = 5;
+    cdt::SmallVector<int, capacity> l;
+};
+constexpr size_t FullSmallvector::capacity;
+
+/// Copy construction throws once armed, and there is no move constructor
+struct ThrowingCopy {
+    static bool armed;
+    ThrowingCopy(int v) : value(v){};
+    ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+        if (armed) {
+            throw std::runtime_error("copy");
+        }
+    }
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+    int value;
+};
+bool ThrowingCopy::armed = false;
+
+/* ------------------------------------------------------------- */
+TEST(SmallVector, EmptySize) {
+    cdt::SmallVector<int, 4> l;
+    ASSERT_EQ(0, l.size());
+    ASSERT_TRUE(l.empty());
+    ASSERT_EQ(4, l.capacity());
+    ASSERT_TRUE(l.is_inline());
+    ASSERT_EQ(l.begin(), l.end());
+    ASSERT_EQ(0, l.spill_stats().overflows);
+}
+
+TEST_F(FullSmallvector, Access) {
+    ASSERT_TRUE(l.is_inline());
+    for (size_t i = 0; i < capacity; i++) {
+        ASSERT_EQ(static_cast<int>(i), l[i]);
+        ASSERT_EQ(static_cast<int>(i), l.at(i));
+    }
+    ASSERT_EQ(0, l.front());
+    ASSERT_EQ(4, l.back());
+    ASSERT_THROW(l[capacity], std::out_of_range);
+    ASSERT_THROW(l.at(capacity), std::out_of_range);
+    ASSERT_EQ(0, l.spill_stats().overflows);
+    ASSERT_EQ(capacity, l.spill_stats().high_water_mark);
+}
+
+TEST_F(FullSmallvector, Spill) {
+    l.push_back(5);
+    ASSERT_FALSE(l.is_inline());
+    ASSERT_EQ(2 * capacity, l.capacity());
+    for (int i = 6; i < 12; i++) {
+        l.push_back(i);
+    }
+    ASSERT_EQ(4 * capacity, l.capacity());
+    ASSERT_EQ(12, l.size());
+    for (int i = 0; i < 12; i++) {
+        ASSERT_EQ(i, l[i]);
+    }
+    const cdt::SpillStats stats = l.spill_stats();
+    ASSERT_EQ(2, stats.overflows);
+    ASSERT_EQ(1, stats.spills);
+    ASSERT_EQ(1, stats.reallocations);
+    ASSERT_EQ(0, stats.drops);
+    ASSERT_EQ(12, stats.high_water_mark);
+}
+
+TEST_F(FullSmallvector, SpillElementOfItself) {
+    l.push_back(l[2]); // The reference into the inline storage has to survive the spill
+    ASSERT_EQ(2, l.back());
+    l.emplace_back(l.front());
+    ASSERT_EQ(0, l.back());
+}
+
+TEST_F(FullSmallvector, ShrinkToFit) {
+    l.push_back(5);
+    l.shrink_to_fit(); // Too large to move back
+    ASSERT_FALSE(l.is_inline());
+    l.pop_back();
+    l.erase(size_t(0));
+    l.clear();
+    ASSERT_EQ(2 * capacity, l.capacity()); // clear() keeps the heap storage
+    l.push_back(7);
+    l.shrink_to_fit();
+    ASSERT_TRUE(l.is_inline());
+    ASSERT_EQ(capacity, l.capacity());
+    ASSERT_EQ(7, l[0]);
+}
+
+TEST_F(FullSmallvector, Reserve) {
+    l.reserve(3);
+    ASSERT_TRUE(l.is_inline());
+    l.reserve(100);
+    ASSERT_EQ(100, l.capacity());
+    ASSERT_EQ(4, l[4]);
+    ASSERT_EQ(1, l.spill_stats().spills);
+    ASSERT_EQ(0, l.spill_stats().overflows);
+
+    cdt::SmallVector<int, 4, cdt::ThrowOnOverflow> fixed;
+    fixed.reserve(4);
+    ASSERT_THROW(fixed.reserve(5), std::length_error);
+}
+
+TEST(SmallVector, ThrowOnOverflow) {
+    cdt::SmallVector<int, 3, cdt::ThrowOnOverflow> l;
+    for (int i = 0; i < 3; i++) {
+        l.push_back(i);
+    }
+    ASSERT_THROW(l.push_back(3), std::out_of_range);
+    ASSERT_THROW(l.emplace_back(3), std::out_of_range);
+    ASSERT_EQ(3, l.size());
+    ASSERT_TRUE(l.is_inline());
+    ASSERT_EQ(2, l.spill_stats().overflows);
+    ASSERT_EQ(0, l.spill_stats().spills);
+}
+
+TEST(SmallVector, DropOldest) {
+    cdt::SmallVector<int, 4, cdt::DropOldest> l;
+    for (int i = 0; i < 10; i++) {
+        l.push_back(i);
+    }
+    ASSERT_EQ((std::vector<int>{6, 7, 8, 9}), std::vector<int>(l.begin(), l.end()));
+    ASSERT_TRUE(l.is_inline());
+    ASSERT_EQ(6, l.spill_stats().overflows);
+    ASSERT_EQ(6, l.spill_stats().drops);
+    ASSERT_EQ(4, l.spill_stats().high_water_mark);
+    l.push_back(l.front()); // The dropped element is read first
+    ASSERT_EQ((std::vector<int>{7, 8, 9, 6}), std::vector<int>(l.begin(), l.end()));
+}
+
+TEST_F(FullSmallvector, Erase) {
+    l.erase(l.begin() + 1); // The last element takes its place
+    ASSERT_EQ((std::vector<int>{0, 4, 2, 3}), std::vector<int>(l.begin(), l.end()));
+    l.pop_front();
+    ASSERT_EQ((std::vector<int>{3, 4, 2}), std::vector<int>(l.begin(), l.end()));
+    ASSERT_THROW(l.erase(l.end()), std::out_of_range);
+    l.push_back(2);
+    ASSERT_EQ(2, l.remove(2));
+    ASSERT_EQ(1, l.erase_if([](int x) { return x == 4; }));
+    ASSERT_EQ(1, l.erase_if_unordered([](int x) { return x == 3; }));
+    ASSERT_TRUE(l.empty());
+}
+
+TEST_F(FullSmallvector, Search) {
+    l.push_back(3);
+    ASSERT_EQ(l.begin() + 3, l.find(3));
+    ASSERT_EQ(l.end(), l.find(9));
+    ASSERT_EQ(2, l.count(3));
+    ASSERT_TRUE(l.contains(4));
+    ASSERT_EQ(0, *l.min_element());
+    ASSERT_EQ(4, *l.max_element());
+}
+
+TEST_F(FullSmallvector, CopyAndMove) {
+    cdt::SmallVector<int, capacity> inline_copy(l);
+    ASSERT_TRUE(inline_copy.is_inline());
+    ASSERT_TRUE(std::equal(l.begin(), l.end(), inline_copy.begin()));
+
+    l.push_back(5);
+    cdt::SmallVector<int, capacity> heap_copy(l);
+    ASSERT_FALSE(heap_copy.is_inline());
+    ASSERT_EQ(6, heap_copy.size());
+    ASSERT_EQ(0, heap_copy.spill_stats().overflows); // Copies start with fresh counters
+    ASSERT_EQ(6, heap_copy.spill_stats().high_water_mark);
+
+    const int* storage = l.begin();
+    cdt::SmallVector<int, capacity> moved(std::move(l));
+    ASSERT_EQ(storage, moved.begin()); // The heap storage is taken over
+    ASSERT_TRUE(l.empty());
+    ASSERT_TRUE(l.is_inline());
+
+    inline_copy = moved;
+    ASSERT_EQ(6, inline_copy.size());
+    ASSERT_EQ(5, inline_copy.back());
+    inline_copy = std::move(heap_copy);
+    ASSERT_EQ(6, inline_copy.size());
+    ASSERT_TRUE(heap_copy.empty());
+    moved = std::move(l);
+    ASSERT_TRUE(moved.empty());
+    moved.push_back(1);
+    ASSERT_EQ(1, moved[0]);
+}
+
+static_assert(std::is_nothrow_move_constructible<cdt::SmallVector<int, 4>>::value &&
+                      std::is_nothrow_move_assignable<cdt::SmallVector<std::string, 4>>::value,
+              "SmallVector moves do not throw, if moving its elements does not.");
+static_assert(!std::is_nothrow_move_constructible<cdt::SmallVector<Tracked, 4>>::value,
+              "SmallVector moves may throw, if moving its elements may.");
+
+TEST(SmallVectorLifetime, Spill) {
+    {
+        cdt::SmallVector<Tracked, 2> l;
+        for (int i = 0; i < 9; i++) {
+            l.emplace_back(i);
+        }
+        ASSERT_EQ(9, Tracked::alive);
+        cdt::SmallVector<Tracked, 2> c(l);
+        ASSERT_EQ(18, Tracked::alive);
+        l.pop_back();
+        l.erase(size_t(0));
+        ASSERT_EQ(16, Tracked::alive);
+        c.clear();
+        ASSERT_EQ(7, Tracked::alive);
+        c = std::move(l);
+        ASSERT_EQ(7, Tracked::alive);
+        ASSERT_EQ(7, c[0].value);
+        while (c.size() > 2) {
+            c.pop_back();
+        }
+        c.shrink_to_fit();
+        ASSERT_TRUE(c.is_inline());
+        ASSERT_EQ(2, Tracked::alive);
+        ASSERT_EQ(1, c[1].value);
+    }
+    ASSERT_EQ(0, Tracked::alive);
+}
+
+TEST(SmallVectorLifetime, DropOldest) {
+    {
+        cdt::SmallVector<Tracked, 3, cdt::DropOldest> l;
+        for (int i = 0; i < 10; i++) {
+            l.emplace_back(i);
+        }
+        ASSERT_EQ(3, Tracked::alive);
+        ASSERT_EQ(7, l.front().value);
+    }
+    ASSERT_EQ(0, Tracked::alive);
+}
+
+TEST(SmallVector, SpillKeepsElementsIfCopyThrows) {
+    cdt::SmallVector<ThrowingCopy, 2> l;
+    l.emplace_back(1);
+    l.emplace_back(2);
+    ThrowingCopy::armed = true;
+    ASSERT_THROW(l.emplace_back(3), std::runtime_error);
+    ThrowingCopy::armed = false;
+    ASSERT_TRUE(l.is_inline());
+    ASSERT_EQ(2, l.size());
+    ASSERT_EQ(2, l[1].value);
+    ASSERT_EQ(0, l.spill_stats().spills);
+}
+
+TEST(SmallVector, MoveOnly) {
+    cdt::SmallVector<std::unique_ptr<int>, 2> l;
+    for (int i = 0; i < 5; i++) {
+        l.emplace_back(new int(i));
+    }
+    ASSERT_EQ(4, *l.back());
+    cdt::SmallVector<std::unique_ptr<int>, 2> m(std::move(l));
+    ASSERT_EQ(5, m.size());
+    ASSERT_EQ(0, *m.front());
+}
+
+TEST(SmallVector, String) {
+    cdt::SmallVector<std::string, 2> l;
+    l.push_back("first element, long enough to be allocated");
+    l.push_back("second");
+    l.push_back("third");
+    l.erase(size_t(0));
+    ASSERT_EQ("third", l[0]);
+    ASSERT_EQ("second", l[1]);
+}
+
+TEST(SmallVector, RandomAgainstVector) {
+    cdt::SmallVector<int, 8> l;
+    std::vector<int> reference;
+    std::mt19937 rng(5);
+    for (int step = 0; step < 20000; step++) {
+        if (rng() % 24 >= reference.size()) { // Bursts around the inline capacity
+            l.push_back(step);
+            reference.push_back(step);
+        } else {
+            const size_t k = rng() % reference.size();
+            l.erase(k);
+            reference[k] = reference.back();
+            reference.pop_back();
+        }
+        if (rng() % 64 == 0) {
+            l.shrink_to_fit();
+        }
+        ASSERT_EQ(reference.size(), l.size());
+        ASSERT_EQ(l.is_inline(), l.capacity() == 8);
+        if (step % 100 == 0) {
+            ASSERT_TRUE(std::equal(reference.begin(), reference.end(), l.begin()));
+        }
+    }
+    ASSERT_GT(l.spill_stats().spills, 1);
+}
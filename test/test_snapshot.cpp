@@ -0,0 +1,185 @@
+#include <array_list/arraylist.hpp>
+#include <array_list/fixedvector.hpp>
+#include <cstdint>
+#include <vector>
+#include "gtest/gtest.h"
+
+struct Point {
+    double x;
+    double y;
+};
+
+/// Buffer aligned for every element type of this test
+struct Buffer {
+    explicit Buffer(size_t n) : words((n + 7) / 8) {
+    }
+    void* data() {
+        return words.data();
+    }
+    size_t size() const {
+        return words.size() * 8;
+    }
+    std::vector<uint64_t> words;
+};
+
+/* ------------------------------------------------------------- */
+TEST(FixedvectorSnapshot, RoundTrip) {
+    cdt::FixedVector<Point, 16> v;
+    for (int i = 0; i < 5; i++) {
+        v.push_back(Point{double(i), double(-i)});
+    }
+    Buffer buffer(v.snapshot_size());
+    ASSERT_EQ(v.snapshot_size(), v.snapshot(buffer.data(), buffer.size()));
+
+    cdt::FixedVector<Point, 16> r;
+    r.push_back(Point{9, 9});
+    r.restore(buffer.data(), buffer.size());
+    ASSERT_EQ(5, r.size());
+    for (int i = 0; i < 5; i++) {
+        ASSERT_EQ(i, r[i].x);
+        ASSERT_EQ(-i, r[i].y);
+    }
+}
+
+TEST(FixedvectorSnapshot, SizeFollowsElements) {
+    cdt::FixedVector<int, 16> v;
+    const size_t empty = v.snapshot_size();
+    v.push_back(1);
+    v.push_back(2);
+    ASSERT_EQ(empty + 2 * sizeof(int), v.snapshot_size());
+}
+
+TEST(FixedvectorSnapshot, View) {
+    cdt::FixedVector<int, 16> v;
+    for (int i = 0; i < 7; i++) {
+        v.push_back(i * i);
+    }
+    Buffer buffer(v.snapshot_size());
+    v.snapshot(buffer.data(), buffer.size());
+
+    cdt::FixedVector<int, 16>::View view(buffer.data(), buffer.size());
+    ASSERT_EQ(7, view.size());
+    ASSERT_EQ(std::vector<int>(v.begin(), v.end()), std::vector<int>(view.begin(), view.end()));
+    ASSERT_EQ(36, view[6]);
+    // The view reads the buffer in place
+    ASSERT_GE(static_cast<const void*>(view.begin()), buffer.data());
+    ASSERT_LT(static_cast<const void*>(view.begin()), static_cast<char*>(buffer.data()) + buffer.size());
+}
+
+TEST(FixedvectorSnapshot, BufferTooSmall) {
+    cdt::FixedVector<int, 16> v;
+    v.push_back(1);
+    Buffer buffer(v.snapshot_size());
+    ASSERT_THROW(v.snapshot(buffer.data(), v.snapshot_size() - 1), std::length_error);
+}
+
+TEST(FixedvectorSnapshot, Mismatch) {
+    cdt::FixedVector<int, 16> v;
+    v.push_back(1);
+    Buffer buffer(v.snapshot_size());
+    v.snapshot(buffer.data(), buffer.size());
+
+    cdt::FixedVector<int, 17> other_capacity;
+    ASSERT_THROW(other_capacity.restore(buffer.data(), buffer.size()), std::invalid_argument);
+    cdt::FixedVector<int16_t, 16> other_type;
+    ASSERT_THROW(other_type.restore(buffer.data(), buffer.size()), std::invalid_argument);
+    cdt::ArrayList<int, 16> other_container;
+    ASSERT_THROW(other_container.restore(buffer.data(), buffer.size()), std::invalid_argument);
+
+    cdt::FixedVector<int, 16> r;
+    r.push_back(5);
+    ASSERT_THROW(r.restore(buffer.data(), v.snapshot_size() - 1), std::invalid_argument);
+    ASSERT_THROW(r.restore(buffer.data(), 8), std::invalid_argument);
+    static_cast<uint32_t*>(buffer.data())[0] ^= 1; // Magic
+    ASSERT_THROW(r.restore(buffer.data(), buffer.size()), std::invalid_argument);
+    ASSERT_EQ(1, r.size()); // Untouched on failure
+    ASSERT_EQ(5, r[0]);
+}
+
+TEST(FixedvectorSnapshot, Misaligned) {
+    cdt::FixedVector<int, 16> v;
+    v.push_back(1);
+    Buffer buffer(v.snapshot_size() + 8);
+    char* shifted = static_cast<char*>(buffer.data()) + 1;
+    v.snapshot(shifted, buffer.size() - 1);
+    typedef cdt::FixedVector<int, 16>::View View;
+    ASSERT_THROW(View(shifted, buffer.size() - 1), std::invalid_argument);
+    // Restoring copies, so it does not care about alignment
+    cdt::FixedVector<int, 16> r;
+    r.restore(shifted, buffer.size() - 1);
+    ASSERT_EQ(1, r[0]);
+}
+
+template <typename _Layout>
+class ArraylistSnapshot : public ::testing::Test {};
+typedef ::testing::Types<cdt::InterleavedLayout, cdt::SplitLayout> Layouts;
+TYPED_TEST_SUITE(ArraylistSnapshot, Layouts);
+
+TYPED_TEST(ArraylistSnapshot, RoundTrip) {
+    typedef cdt::ArrayList<int, 32, TypeParam> List;
+    List l;
+    for (int i = 0; i < 10; i++) {
+        l.push_back(i);
+    }
+    l.remove_if([](int x) { return x % 3 == 0; });
+    l.push_front(100); // Recycles a slot
+    Buffer buffer(List::snapshot_size());
+    ASSERT_EQ(List::snapshot_size(), l.snapshot(buffer.data(), buffer.size()));
+
+    List r;
+    r.push_back(5);
+    r.restore(buffer.data(), buffer.size());
+    ASSERT_EQ(std::vector<int>(l.begin(), l.end()), std::vector<int>(r.begin(), r.end()));
+    ASSERT_EQ(l.size(), r.size());
+    ASSERT_EQ(l.is_contiguous(), r.is_contiguous());
+
+    // The restored list keeps working, including its free list
+    for (size_t i = r.size(); i < r.max_size(); i++) {
+        r.push_back(-1);
+    }
+    ASSERT_THROW(r.push_back(0), std::length_error);
+    r.erase(r.begin());
+    ASSERT_EQ(1, r.front());
+    ASSERT_EQ(4, r[2]);
+}
+
+TYPED_TEST(ArraylistSnapshot, View) {
+    typedef cdt::ArrayList<int, 32, TypeParam> List;
+    List l;
+    for (int i = 0; i < 10; i++) {
+        l.push_back(i);
+    }
+    l.reverse();
+    l.erase(l.nth(3));
+    Buffer buffer(List::snapshot_size());
+    l.snapshot(buffer.data(), buffer.size());
+
+    typename List::View view(buffer.data(), buffer.size());
+    ASSERT_EQ(l.size(), view.size());
+    ASSERT_EQ(std::vector<int>(l.begin(), l.end()), std::vector<int>(view.begin(), view.end()));
+}
+
+TYPED_TEST(ArraylistSnapshot, Empty) {
+    typedef cdt::ArrayList<int, 4, TypeParam> List;
+    List l;
+    Buffer buffer(List::snapshot_size());
+    l.snapshot(buffer.data(), buffer.size());
+    typename List::View view(buffer.data(), buffer.size());
+    ASSERT_TRUE(view.empty());
+    ASSERT_TRUE(view.begin() == view.end());
+    List r;
+    r.push_back(1);
+    r.restore(buffer.data(), buffer.size());
+    ASSERT_TRUE(r.empty());
+}
+
+TEST(ArraylistSnapshotLayout, Mismatch) {
+    cdt::ArrayList<int, 8, cdt::InterleavedLayout> l;
+    l.push_back(1);
+    Buffer buffer(l.snapshot_size());
+    l.snapshot(buffer.data(), buffer.size());
+    cdt::ArrayList<int, 8, cdt::SplitLayout> split;
+    ASSERT_THROW(split.restore(buffer.data(), buffer.size()), std::invalid_argument);
+    cdt::ArrayList<int, 300, cdt::InterleavedLayout> wider_index;
+    ASSERT_THROW(wider_index.restore(buffer.data(), buffer.size()), std::invalid_argument);
+}
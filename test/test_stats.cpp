@@ -0,0 +1,138 @@
+#define CDT_ENABLE_STATS 1
+#include <array_list/arraylist.hpp>
+#include <array_list/fixedvector.hpp>
+#include <iterator>
+#include <vector>
+#include "gtest/gtest.h"
+
+// All containers of this test record their usage.
+
+/* ------------------------------------------------------------- */
+TEST(ArraylistStats, StartAtZero) {
+    cdt::ArrayList<int, 8> l;
+    cdt::UsageStats s = l.stats();
+    ASSERT_EQ(0, s.high_water_mark);
+    ASSERT_EQ(0, s.inserts);
+    ASSERT_EQ(0, s.erases);
+    ASSERT_EQ(0, s.overflows);
+    ASSERT_EQ(0, s.recycled);
+    ASSERT_EQ(0, s.scans);
+}
+
+TEST(ArraylistStats, InsertErase) {
+    cdt::ArrayList<int, 8> l;
+    for (int i = 0; i < 6; i++) {
+        l.push_back(i);
+    }
+    l.erase(l.begin());
+    l.erase(l.nth(1), l.nth(3));
+    l.push_front(1); // Takes a slot from the free list
+    ASSERT_EQ(6, l.stats().high_water_mark);
+    ASSERT_EQ(7, l.stats().inserts);
+    ASSERT_EQ(3, l.stats().erases);
+    ASSERT_EQ(1, l.stats().recycled);
+    l.clear();
+    ASSERT_EQ(7, l.stats().erases);
+    ASSERT_EQ(6, l.stats().high_water_mark);
+}
+
+TEST(ArraylistStats, RemoveIfAndUnique) {
+    cdt::ArrayList<int, 8> l;
+    l.assign({1, 1, 2, 3, 3, 4});
+    l.unique();
+    ASSERT_EQ(2, l.stats().erases);
+    l.remove_if([](int x) { return x % 2 == 0; });
+    ASSERT_EQ(4, l.stats().erases);
+}
+
+TEST(ArraylistStats, Overflow) {
+    cdt::ArrayList<int, 2> l;
+    l.assign({1, 2});
+    ASSERT_THROW(l.push_back(3), std::length_error);
+    ASSERT_THROW(l.insert(l.end(), 3, 0), std::length_error);
+    ASSERT_EQ(2, l.stats().overflows);
+    ASSERT_EQ(2, l.stats().inserts);
+}
+
+TEST(ArraylistStats, ScanLength) {
+    cdt::ArrayList<int, 16> l;
+    for (int i = 0; i < 16; i++) {
+        l.push_back(i);
+    }
+    ASSERT_EQ(4, l[4]); // Walks 4 links from the front
+    ASSERT_EQ(5, l[5]); // Walks 1 link from the cached position
+    cdt::UsageStats s = l.stats();
+    ASSERT_EQ(2, s.scans);
+    ASSERT_EQ(5, s.scan_steps);
+    ASSERT_EQ(4, s.max_scan_length);
+    ASSERT_EQ(15, l.index_of(--l.end())); // Next to end
+    ASSERT_EQ(3, l.stats().scans);
+    ASSERT_EQ(4, l.stats().max_scan_length);
+}
+
+TEST(ArraylistStats, ConstAccessKeepsCursor) {
+    cdt::ArrayList<int, 16> l;
+    for (int i = 0; i < 16; i++) {
+        l.push_back(i);
+    }
+    const auto& cl = l;
+    ASSERT_EQ(7, l[7]);  // Walks 7 links from the front and caches the position
+    ASSERT_EQ(2, cl[2]); // Walks 2 links from the front, the cache is only read
+    ASSERT_EQ(8, cl[8]); // Walks 1 link from the position cached by l[7]
+    auto it = cl.begin();
+    std::advance(it, 8);
+    ASSERT_EQ(8, cl.index_of(it)); // 1 step back to the cached position
+    ASSERT_EQ(4, l.stats().scans);
+    ASSERT_EQ(11, l.stats().scan_steps);
+}
+
+TEST(ArraylistStats, Reset) {
+    cdt::ArrayList<int, 8> l;
+    l.assign({1, 2, 3, 4});
+    l.pop_back();
+    l.reset_stats();
+    ASSERT_EQ(0, l.stats().inserts);
+    ASSERT_EQ(0, l.stats().erases);
+    ASSERT_EQ(3, l.stats().high_water_mark); // Restarts from the current size
+}
+
+TEST(ArraylistStats, NotCopied) {
+    cdt::ArrayList<int, 8> l;
+    l.assign({1, 2, 3});
+    l.pop_back();
+    cdt::ArrayList<int, 8> c(l);
+    ASSERT_EQ(0, c.stats().erases);
+    ASSERT_EQ(2, c.stats().inserts);
+    c = l;
+    ASSERT_EQ(2, c.stats().erases);
+    ASSERT_EQ(1, l.stats().erases);
+}
+
+TEST(FixedvectorStats, InsertEraseOverflow) {
+    cdt::FixedVector<int, 4> v;
+    for (int i = 0; i < 4; i++) {
+        v.push_back(i);
+    }
+    ASSERT_THROW(v.push_back(4), std::out_of_range);
+    v.erase(v.begin());
+    v.erase_if([](int x) { return x > 1; });
+    cdt::UsageStats s = v.stats();
+    ASSERT_EQ(4, s.high_water_mark);
+    ASSERT_EQ(4, s.inserts);
+    ASSERT_EQ(3, s.erases);
+    ASSERT_EQ(1, s.overflows);
+    v.clear();
+    ASSERT_EQ(4, v.stats().erases);
+}
+
+TEST(FixedvectorStats, Copy) {
+    cdt::FixedVector<int, 4> v;
+    v.push_back(1);
+    v.push_back(2);
+    cdt::FixedVector<int, 4> c(v);
+    ASSERT_EQ(2, c.stats().inserts);
+    ASSERT_EQ(2, c.stats().high_water_mark);
+    cdt::FixedVector<int, 4> m(std::move(c));
+    ASSERT_EQ(2, m.stats().inserts);
+    ASSERT_EQ(2, c.stats().erases);
+}
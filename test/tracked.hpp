@@ -0,0 +1,28 @@
+#pragma once
+
+/// Static counter of Tracked, a template so that the header can define it
+template <typename = void>
+struct TrackedCounter {
+    static int alive;
+};
+template <typename _Tag>
+int TrackedCounter<_Tag>::alive = 0;
+
+/// Payload without default constructor, which counts its live instances to check that containers construct and
+/// destroy their elements exactly once. Moves are copies, so they count as well.
+struct Tracked : TrackedCounter<> {
+    Tracked(int v) : value(v) {
+        ++alive;
+    }
+    Tracked(const Tracked& other) : value(other.value) {
+        ++alive;
+    }
+    Tracked& operator=(const Tracked&) = default;
+    ~Tracked() {
+        --alive;
+    }
+    bool operator<(const Tracked& other) const {
+        return value < other.value;
+    }
+    int value;
+};